@@ -0,0 +1,222 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/fault_sim.cpp - fault injection: recovery time + loop latency
+ *
+ * Runs the whole firmware (default smart_bin.h
+ * config) against the world models and injects
+ * one fault per scenario. Every boot is a fork()
+ * of a process that has never run the firmware,
+ * so .data/.bss start fresh exactly as after a
+ * reset; the virtual clock, MCUSR, EEPROM and
+ * the .noinit section are carried across.
+ *
+ *   fault_sim [scenario]
+ *
+ * BIO reads full from 90 s, so it is locked
+ * (and its FULL alert sent or logged) before
+ * any fault and must stay locked through
+ * every warm boot: in RAM, and its servo
+ * never leaves SERVO_LOCKED. Exit status 1
+ * if it does.
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+extern uint8_t __start_host_noinit[], __stop_host_noinit[];
+
+static const uint64_t S = 1000000ULL;
+
+enum FaultKind { F_MODEM, F_LCD, F_HANG };
+
+struct Scenario {
+    const char* name;
+    FaultKind   kind;
+    uint32_t    faultS, clearS, endS;
+    bool        init3;          // .init3 watchdog hook runs
+    const char* what;
+};
+
+static const Scenario SCENARIOS[] = {
+    { "modem-outage",  F_MODEM, 60,  660, 1200, true,  "SIM800 silent for 10 min" },
+    { "lcd-unplug",    F_LCD,   120, 720, 1200, true,  "both LCDs NACK for 10 min" },
+    { "loop-hang",     F_HANG,  120, 120, 600,  true,  "one I2C call hangs 10 s" },
+    { "hang-no-init3", F_HANG,  120, 120, 300,  false, "as loop-hang, WDRF left set" },
+};
+
+/* Survives every boot of one scenario */
+struct Shared {
+    uint64_t nowUs;
+    uint8_t  mcusr;
+    uint8_t  eeprom[1024];
+    uint8_t  noinit[64];
+    world::ModemStats modem;
+
+    uint32_t boots, wdtResets, warmBoots, warmLockLost;
+    uint32_t lockOpened;        // BIO servo moved off LOCKED while locked
+    bool     bioLocked;
+    bool     hangFired;
+    uint32_t bootAtFault;
+    uint64_t faultUs;
+    uint32_t initsAtClear;
+    bool     clearSeen;
+    uint64_t recoveredUs;
+    uint64_t modemBackUs;
+    uint64_t loopMaxUs[3];      // before / during / after the fault
+    uint8_t  healthReboots;
+    uint8_t  smsLogged;
+};
+
+static Shared*         sh;
+static const Scenario* sc;
+
+/* -------------------------------------------
+   FAULTS
+   ------------------------------------------- */
+static bool inFault()
+{
+    uint64_t t = host::nowUs;
+    return t >= sc->faultS * S && t < sc->clearS * S;
+}
+
+static uint8_t i2cProbe(uint8_t addr)
+{
+    if (sc->kind == F_LCD && inFault() && (addr == 0x27 || addr == 0x25)) return 2;
+    if (sc->kind == F_HANG && !sh->hangFired && host::nowUs >= sc->faultS * S) {
+        sh->hangFired   = true;
+        sh->faultUs     = host::nowUs;
+        sh->bootAtFault = sh->boots;
+        host::advance(10 * S);              // stuck bus, no Wire timeout
+    }
+    return 0;
+}
+
+/* BIO is never emptied or carded here, so once it is locked any
+   other angle opens a full bin */
+static void servoWrite(Servo &s, int deg)
+{
+    if (&s == &servoBio && sh->bioLocked && deg != SERVO_LOCKED) sh->lockOpened++;
+}
+
+/* -------------------------------------------
+   ONE BOOT (child process)
+   ------------------------------------------- */
+static void boot()
+{
+    host::nowUs        = sh->nowUs;
+    host::millisTickUs = 10;
+    MCUSR              = sh->mcusr;
+    if (MCUSR & (1 << WDRF)) host::wdtSet(true, 16);
+    memcpy(EEPROM.mem, sh->eeprom, sizeof(EEPROM.mem));
+    if (sh->boots) memcpy(__start_host_noinit, sh->noinit, __stop_host_noinit - __start_host_noinit);
+    sh->boots++;
+
+    world::modemStats = &sh->modem;
+    world::modemAttach();
+    world::echoAttach();
+    host::i2c = i2cProbe;
+    Servo::onWrite = servoWrite;
+    world::echoCm[PIN_ECHO_BIO] = 80;
+    world::echoCm[PIN_ECHO_NON] = 40;
+
+    try {
+        if (sc->init3) wdtBootInit();
+        setup();
+        if (sh->boots > 1 && sh->bioLocked) {
+            sh->warmBoots++;
+            if (!binBio.locked) sh->warmLockLost++;
+        }
+
+        uint64_t last = host::nowUs;
+        while (host::nowUs < sc->endS * S) {
+            world::modemUp = !(sc->kind == F_MODEM && inFault());
+            world::echoCm[PIN_ECHO_BIO] = host::nowUs >= 90 * S ? 5 : 80;
+            world::gpsFeed(host::nowUs + 2 * S);
+
+            loop();
+
+            uint64_t now   = host::nowUs;
+            int      phase = now < sc->faultS * S ? 0 : now < sc->clearS * S ? 1 : 2;
+            if (sc->kind == F_HANG) phase = !sh->hangFired ? 0 : sh->boots > sh->bootAtFault ? 2 : 1;
+            if (now - last > sh->loopMaxUs[phase]) sh->loopMaxUs[phase] = now - last;
+            last = now;
+            sh->bioLocked = binBio.locked;
+
+            if (phase == 2 && !sh->clearSeen) {
+                sh->clearSeen    = true;
+                sh->initsAtClear = sh->modem.inits;
+            }
+            if (phase == 2 && !sh->recoveredUs) {
+                bool ok = sc->kind == F_MODEM ? subOK(SUB_MODEM)
+                        : sc->kind == F_LCD   ? subOK(SUB_LCD)
+                        : true;
+                if (ok) sh->recoveredUs = now;
+            }
+            if (!sh->modemBackUs && !strncmp(sh->modem.lastSms, "MODEM BACK", 10))
+                sh->modemBackUs = sh->modem.lastSmsUs;
+        }
+    } catch (host::Reset &) {
+        sh->wdtResets++;
+    }
+
+    sh->nowUs         = host::nowUs;
+    sh->mcusr         = MCUSR;
+    sh->healthReboots = healthReboots;
+    sh->smsLogged     = EEPROM.read(EE_SMS_LOG);
+    memcpy(sh->eeprom, EEPROM.mem, sizeof(EEPROM.mem));
+    memcpy(sh->noinit, __start_host_noinit, __stop_host_noinit - __start_host_noinit);
+    fflush(stdout);
+    _exit(0);
+}
+
+/* -------------------------------------------
+   ONE SCENARIO (parent)
+   ------------------------------------------- */
+static bool run(const Scenario &s)
+{
+    sc = &s;
+    memset(sh, 0, sizeof(*sh));
+    sh->mcusr = 1;                          // PORF
+    memset(sh->eeprom, 0xFF, sizeof(sh->eeprom));
+
+    while (sh->nowUs < s.endS * S && sh->boots < 100000) {
+        pid_t pid = fork();
+        if (pid == 0) boot();
+        int st;
+        waitpid(pid, &st, 0);
+        if (!WIFEXITED(st)) { printf("%-14s boot %u crashed\n", s.name, sh->boots); return false; }
+    }
+
+    uint64_t ref = s.kind == F_HANG ? sh->faultUs : s.clearS * S;
+    char rec[24], back[24];
+    if (sh->recoveredUs) snprintf(rec, sizeof(rec), "%.1f s", (sh->recoveredUs - ref) / 1e6);
+    else                 snprintf(rec, sizeof(rec), "never");
+    if (sh->modemBackUs) snprintf(back, sizeof(back), "%.1f s", (sh->modemBackUs - ref) / 1e6);
+    else                 snprintf(back, sizeof(back), "-");
+
+    printf("%-14s %-28s %6u %7u %8u/%-3u %6u %9s %10s %6u %7.0f %7.0f %7.0f\n",
+           s.name, s.what, sh->wdtResets, sh->healthReboots,
+           sh->warmBoots - sh->warmLockLost, sh->warmBoots, sh->lockOpened, rec, back,
+           sh->modem.inits - sh->initsAtClear,
+           sh->loopMaxUs[0] / 1e3, sh->loopMaxUs[1] / 1e3, sh->loopMaxUs[2] / 1e3);
+    return !sh->warmLockLost && !sh->lockOpened;
+}
+
+int main(int argc, char** argv)
+{
+    sh = (Shared*)mmap(0, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED) { perror("mmap"); return 1; }
+    setvbuf(stdout, 0, _IONBF, 0);
+
+    printf("%-14s %-28s %6s %7s %12s %6s %9s %10s %6s %23s\n",
+           "scenario", "fault", "resets", "reboots", "lock kept", "opened", "recovery", "modem back",
+           "inits", "loop max ms pre/in/post");
+    bool ok = true;
+    for (const Scenario &s : SCENARIOS)
+        if (argc < 2 || !strcmp(argv[1], s.name)) ok = run(s) && ok;
+    if (!ok) printf("FAIL: a locked bin was lost or opened across a reset\n");
+    return ok ? 0 : 1;
+}
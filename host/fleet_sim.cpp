@@ -0,0 +1,369 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/fleet_sim.cpp - fleet simulator / alert load generator
+ *
+ * Runs N boards, two bins each, through the
+ * unmodified updateDistances(), checkRepeatSMS(),
+ * updateTelemetry() and processCard() from
+ * smart_bin.cpp. Each board is a Device context
+ * of its own (bins[], dayStart, lastDailySMS,
+ * lastUSRead, telemetry queue) plus its health[];
+ * dev points at the board being stepped. All
+ * boards walk the same virtual clock, one step
+ * every US_INTERVAL_MS, and are split across
+ * worker processes. The SIM800 model in world.cpp
+ * hands every SMS and telemetry POST to a local
+ * sink instead of the network.
+ *
+ *   fleet_sim [-n boards] [-d days] [-j workers] [-s seed] [-o sink.csv]
+ *
+ * Reports sensor reads/s, wall time per simulated
+ * fleet-month, SMS and POST totals and the
+ * alert-storm peaks (most SMS in one minute /
+ * one hour across the fleet).
+ *
+ * Fill model, per bin: a fill rate of 0.15-0.8 bin
+ * per day, x1.6 from 07:00 to 21:00 and x0.2 at
+ * night. Each echo pulse has +-3cm noise and 0.5%
+ * of reads get no echo at all. The truck visits
+ * every 1-3 days between 06:00 and 08:00, unlocks
+ * a locked bin with a crew card and empties it.
+ * 5% of the boards have no GPRS coverage, so their
+ * POSTs fail and the daily report goes by SMS.
+ *
+ * Every bin draws from its own random stream,
+ * seeded from (seed, bin index), so the results
+ * do not depend on -j.
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+static const uint32_t DAY_S = 86400UL;
+static const uint64_t S     = 1000000ULL;
+
+enum SinkType { SINK_FULL, SINK_REMIND, SINK_AUTH, SINK_DAILY, SINK_POST, SINK_TYPES };
+static const char* const SINK_NAME[SINK_TYPES] = { "FULL", "REMINDER", "AUTH", "DAILY", "POST" };
+
+/* One SMS or POST as the modem would have sent it */
+struct Alert {
+    uint32_t tS;
+    uint32_t board;
+    int8_t   bin;               // -1: the whole board (DAILY, POST)
+    uint8_t  type;
+    uint8_t  n;                 // smsCount after the alert, frames in a POST
+};
+
+/* Fill model for one bin */
+struct Fill {
+    double   level;             // 0 empty, 1 = at fullCm
+    double   ratePerS;
+    uint32_t collectEvery;      // s
+    uint32_t nextCollect;       // s
+    bool     noEcho;            // this step's read drops out
+    uint64_t rs;                // the bin's own random stream
+};
+
+/* One board: what the firmware keeps per device */
+struct Board {
+    BinState b[BIN_COUNT];
+    Device   d;
+    Health   health[SUB_COUNT];
+    Fill     fill[BIN_COUNT];
+    bool     gprs;
+    uint64_t clockUs;           // where the last step left the board's clock
+};
+
+/* Sent back by each worker ahead of its alerts */
+struct Totals {
+    uint64_t reads;
+    uint64_t lockedS;
+    uint64_t postBytes;
+    uint64_t postFails;         // telemFailCount, summed
+    uint32_t noGprs;
+    uint32_t alerts;
+};
+
+static uint32_t gBoards  = 100;
+static uint32_t gDays    = 30;
+
+// Worker state, seen by the hooks
+static Board*             cur;
+static uint32_t           curId;
+static std::vector<Alert> sink;
+static Totals             tot;
+
+/* -------------------------------------------
+   RNG (xorshift64*)
+   ------------------------------------------- */
+static inline double rnd(uint64_t &s)
+{
+    s ^= s >> 12; s ^= s << 25; s ^= s >> 27;
+    return (double)((s * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* splitmix64: a well-mixed, non-zero xorshift state from (seed, bin) */
+static uint64_t binSeed(uint64_t seed, uint64_t bin)
+{
+    uint64_t z = seed * 0x9E3779B97F4A7C15ULL + bin + 1;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z ? z : 1;
+}
+
+/* -------------------------------------------
+   WORLD: ECHO, SMS AND POST FOR THE BOARD
+   BEING STEPPED
+   ------------------------------------------- */
+static unsigned long fleetEcho(uint8_t pin, unsigned long timeoutUs)
+{
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        const BinState &b = cur->b[i];
+        Fill           &f = cur->fill[i];
+        if (b.echo != pin || f.noEcho) continue;
+
+        // Distance to the trash surface, overflowing past fullCm
+        double d  = b.depthCm - f.level * (b.depthCm - b.fullCm) + (rnd(f.rs) - 0.5) * 6.0;
+        long   cm = d < 2.0 ? 2 : (long)d;
+        unsigned long us = (unsigned long)((cm * 2000L + 33) / 34);
+        if (us > timeoutUs) break;
+        host::advance(us);
+        return us;
+    }
+    host::advance(timeoutUs);
+    return 0;
+}
+
+static void fleetSms(uint64_t atUs, const char* text)
+{
+    Alert a = { (uint32_t)(atUs / S), curId, -1, SINK_DAILY, 0 };
+    if      (!strncmp(text, "ALERT: ", 7))     { a.type = SINK_FULL;   a.n = 1; }
+    else if (!strncmp(text, "REMINDER ", 9))   { a.type = SINK_REMIND; a.n = (uint8_t)atoi(text + 9); }
+    else if (!strncmp(text, "AUTH: ", 6))      { a.type = SINK_AUTH; }
+    else if (strncmp(text, "DAILY REPORT", 12)) return;
+
+    // " BIO bin" does not match inside "NON-BIO bin"
+    char key[24];
+    for (uint8_t i = 0; a.type != SINK_DAILY && i < BIN_COUNT; i++) {
+        snprintf(key, sizeof(key), " %s bin", cur->b[i].label);
+        if (strstr(text, key)) a.bin = i;
+    }
+    sink.push_back(a);
+}
+
+static int fleetPost(uint64_t atUs, const char* body, size_t len)
+{
+    sink.push_back(Alert{ (uint32_t)(atUs / S), curId, -1, SINK_POST, (uint8_t)(len / TELEM_FRAME_LEN) });
+    tot.postBytes += len;
+    return 200;
+}
+
+/* -------------------------------------------
+   WORKER: ONE SLICE OF THE FLEET
+   Runs in its own process: health[], dev and
+   the modem model are the firmware's globals.
+   ------------------------------------------- */
+static void runWorker(uint32_t first, uint32_t count, uint64_t seed, FILE* out)
+{
+    const uint32_t stepS = US_INTERVAL_MS / 1000UL;
+    const uint32_t endS  = gDays * DAY_S;
+    std::vector<Board> fleet(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Board &n = fleet[i];
+        n.b[0] = binBio;
+        n.b[1] = binNon;
+        n.d    = Device();
+        for (uint8_t k = 0; k < BIN_COUNT; k++) {
+            Fill &f = n.fill[k];
+            n.d.bins[k]    = &n.b[k];
+            f.rs           = binSeed(seed, (uint64_t)(first + i) * BIN_COUNT + k);
+            f.level        = rnd(f.rs) * 0.5;
+            f.ratePerS     = (0.15 + rnd(f.rs) * 0.65) / DAY_S;
+            f.collectEvery = (1 + (uint32_t)(rnd(f.rs) * 3)) * DAY_S;
+            f.nextCollect  = 6 * 3600 + (uint32_t)(rnd(f.rs) * 7200);
+        }
+        memcpy(n.health, health, sizeof(health));
+        n.gprs     = rnd(n.fill[0].rs) >= 0.05;     // the board's first bin decides
+        n.clockUs  = 0;
+        tot.noGprs += !n.gprs;
+    }
+
+    world::modemAttach();
+    world::smsHook     = fleetSms;
+    world::postHook    = fleetPost;
+    host::pulseIn      = fleetEcho;
+    host::millisTickUs = 10000;         // coarse: waits and halDelay() cost a few polls
+
+    for (uint32_t t = 0; t < endS; t += stepS) {
+        uint32_t hour = (t % DAY_S) / 3600;
+        double   day  = (hour >= 7 && hour < 21) ? 1.6 : 0.2;
+
+        for (uint32_t i = 0; i < count; i++) {
+            Board &n = fleet[i];
+            cur   = &n;
+            curId = first + i;
+            dev   = &n.d;
+            memcpy(health, n.health, sizeof(health));
+            world::gprsUp = n.gprs;
+            host::nowUs   = std::max(n.clockUs, (uint64_t)t * S);
+            // updateDistances()' check and stamp are microseconds apart on
+            // the board: with the coarse tick they would drift the read
+            // past the next step, so these two millis() calls are free
+            host::slackUs = 2 * host::millisTickUs;
+
+            for (uint8_t k = 0; k < BIN_COUNT; k++) {
+                Fill &f = n.fill[k];
+                f.level += f.ratePerS * stepS * day;
+                f.noEcho = rnd(f.rs) < 0.005;
+                if (n.b[k].locked) tot.lockedS += stepS;
+            }
+
+            unsigned long lastRead = n.d.lastUSRead;
+            updateDistances();
+            if (n.d.lastUSRead != lastRead) tot.reads += BIN_COUNT;
+            checkRepeatSMS();
+            updateTelemetry();
+
+            // Truck: crew card on a locked bin, then empty it
+            for (uint8_t k = 0; k < BIN_COUNT; k++) {
+                Fill &f = n.fill[k];
+                if (t < f.nextCollect) continue;
+                f.nextCollect += f.collectEvery;
+                if (n.b[k].locked) processCard(String(AUTH_UID1), n.b[k]);
+                f.level = 0.0;
+            }
+
+            sim800.rxClear();               // trailing OKs belong to this board
+            n.clockUs = host::nowUs;
+            memcpy(n.health, health, sizeof(health));
+        }
+    }
+
+    for (const Board &n : fleet) tot.postFails += n.d.telemFailCount;
+    tot.alerts = (uint32_t)sink.size();
+    fwrite(&tot, sizeof(tot), 1, out);
+    fwrite(sink.data(), sizeof(Alert), sink.size(), out);
+    fflush(out);
+}
+
+/* -------------------------------------------
+   MAIN
+   ------------------------------------------- */
+int main(int argc, char** argv)
+{
+    long        ncpu    = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t    workers = ncpu > 0 ? (uint32_t)ncpu : 1;
+    uint64_t    seed    = 1;
+    const char* out     = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if      (!strcmp(argv[i], "-n")) gBoards = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-d")) gDays   = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-j")) workers = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-s")) seed    = strtoull(argv[i + 1], 0, 0);
+        else if (!strcmp(argv[i], "-o")) out     = argv[i + 1];
+        else { fprintf(stderr, "usage: %s [-n boards] [-d days] [-j workers] [-s seed] [-o sink.csv]\n", argv[0]); return 2; }
+    }
+    if (workers == 0) workers = 1;
+    if (workers > gBoards) workers = gBoards;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<FILE*> res(workers);
+    std::vector<pid_t> pids(workers);
+    fflush(stdout);
+    for (uint32_t k = 0, first = 0; k < workers; k++) {
+        uint32_t count = gBoards / workers + (k < gBoards % workers ? 1 : 0);
+        res[k] = tmpfile();
+        if (!res[k]) { perror("tmpfile"); return 1; }
+        pids[k] = fork();
+        if (pids[k] == 0) {
+            runWorker(first, count, seed, res[k]);
+            _exit(0);
+        }
+        first += count;
+    }
+
+    // Merge the sinks on the shared clock
+    std::vector<Alert> all;
+    Totals sum = {};
+    for (uint32_t k = 0; k < workers; k++) {
+        int st;
+        Totals w;
+        waitpid(pids[k], &st, 0);
+        rewind(res[k]);
+        if (!WIFEXITED(st) || WEXITSTATUS(st) || fread(&w, sizeof(w), 1, res[k]) != 1) {
+            fprintf(stderr, "worker %u failed\n", k);
+            return 1;
+        }
+        size_t base = all.size();
+        all.resize(base + w.alerts);
+        if (fread(all.data() + base, sizeof(Alert), w.alerts, res[k]) != w.alerts) {
+            fprintf(stderr, "worker %u: short sink\n", k);
+            return 1;
+        }
+        fclose(res[k]);
+        sum.reads     += w.reads;
+        sum.lockedS   += w.lockedS;
+        sum.postBytes += w.postBytes;
+        sum.postFails += w.postFails;
+        sum.noGprs    += w.noGprs;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    // Same order whatever the split: one board's alerts keep their own order
+    std::stable_sort(all.begin(), all.end(), [](const Alert &a, const Alert &b) {
+        return a.tS != b.tS ? a.tS < b.tS : a.board < b.board;
+    });
+
+    uint64_t byType[SINK_TYPES] = {};
+    uint64_t sms = 0;
+    std::vector<uint32_t> perMin(gDays * 1440 + 1), perHour(gDays * 24 + 1);
+    for (auto &a : all) {
+        byType[a.type]++;
+        if (a.type == SINK_POST || a.tS >= gDays * DAY_S) continue;
+        sms++;
+        perMin[a.tS / 60]++;
+        perHour[a.tS / 3600]++;
+    }
+    size_t pm = std::max_element(perMin.begin(), perMin.end()) - perMin.begin();
+    size_t ph = std::max_element(perHour.begin(), perHour.end()) - perHour.begin();
+
+    if (out) {
+        FILE* f = fopen(out, "w");
+        if (!f) { perror(out); return 1; }
+        fprintf(f, "t_s,board,bin,type,n\n");
+        for (auto &a : all) {
+            if (a.bin < 0) fprintf(f, "%u,%u,,%s,%u\n", a.tS, a.board, SINK_NAME[a.type], a.n);
+            else           fprintf(f, "%u,%u,%d,%s,%u\n", a.tS, a.board, a.bin, SINK_NAME[a.type], a.n);
+        }
+        fclose(f);
+    }
+
+    uint64_t bins        = (uint64_t)gBoards * BIN_COUNT;
+    double   fleetMonths = gBoards * (gDays / 30.0);
+    printf("boards         %u (%llu bins), %u without GPRS, %u worker(s)\n",
+           gBoards, (unsigned long long)bins, sum.noGprs, workers);
+    printf("simulated      %u days, %llu sensor reads\n", gDays, (unsigned long long)sum.reads);
+    printf("wall           %.2f s, %.2f M reads/s\n", wall, sum.reads / wall / 1e6);
+    printf("fleet-month    %.3f s wall (%.1f board-months/s)\n",
+           wall * 30.0 / gDays, fleetMonths / wall);
+    printf("SMS            FULL %llu  REMINDER %llu  AUTH %llu  DAILY %llu  total %llu (%.2f per bin-day)\n",
+           (unsigned long long)byType[SINK_FULL], (unsigned long long)byType[SINK_REMIND],
+           (unsigned long long)byType[SINK_AUTH], (unsigned long long)byType[SINK_DAILY],
+           (unsigned long long)sms, (double)sms / bins / gDays);
+    printf("POST           %llu OK, %llu failed, %.0f B per board-day\n",
+           (unsigned long long)byType[SINK_POST], (unsigned long long)sum.postFails,
+           (double)sum.postBytes / gBoards / gDays);
+    printf("locked         %.1f%% of bin-time\n", 100.0 * sum.lockedS / ((double)bins * gDays * DAY_S));
+    printf("storm peak     %u SMS/min at day %zu %02zu:%02zu, %u SMS/hour at day %zu %02zu:00\n",
+           perMin[pm], pm / 1440, (pm % 1440) / 60, pm % 60,
+           perHour[ph], ph / 24, ph % 24);
+    if (out) printf("sink           %s\n", out);
+    return 0;
+}
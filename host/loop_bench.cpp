@@ -0,0 +1,92 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/loop_bench.cpp - loop() latency for one module configuration
+ *
+ * Built once per configuration by
+ * tools/footprint.py --matrix --host (or by
+ * make loop_bench LB_DEFS="-D..."). Runs the
+ * firmware for 65 minutes of virtual time
+ * against the world models: GPS bursts, the
+ * SIM800, and a BIO bin that reads full from
+ * 10 to 40 min (FULL SMS, lock, unlock). One
+ * telemetry POST falls in the window. The test
+ * apps get their own Serial commands instead:
+ * CSQ every minute and one SMS for the modem
+ * test, LOCKBIO / UNLOCKBIO for the servo test.
+ *
+ *   loop_bench [minutes]
+ *
+ * Prints one line, parsed by footprint.py:
+ *   loops N  avg A ms  p99 P ms  max M ms
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+static const uint64_t S   = 1000000ULL;
+static const uint64_t MIN = 60 * S;
+static const uint32_t BIN_US  = 100;            // histogram: 0.1 ms buckets
+static const uint32_t BUCKETS = 300000;         // up to 30 s, the last one open
+
+static std::vector<uint32_t> hist(BUCKETS);
+
+/* Serial commands a test app gets at the start of minute m */
+static const char* command(uint32_t m)
+{
+    if (APP_MODE == APP_MODEM_TEST) return m == 10 ? "SMS bench\n" : "CSQ\n";
+    if (APP_MODE == APP_SERVO_TEST) return (m & 1) ? "LOCKBIO\n" : "UNLOCKBIO\n";
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t endUs = (uint64_t)(argc > 1 ? atof(argv[1]) : 65) * MIN;
+    bool     gps   = APP_MODE == APP_BIN || APP_MODE == APP_GPS_TEST;
+
+    host::millisTickUs = 10;
+    world::modemAttach();
+    world::echoAttach();
+    world::echoCm[PIN_ECHO_BIO] = 80;
+    world::echoCm[PIN_ECHO_NON] = 40;
+
+    uint64_t loops = 0, sumUs = 0, maxUs = 0;
+    try {
+        if (gps) world::gpsFeed(2 * S);
+        setup();
+        uint32_t nextCmd = 1;
+        uint64_t last    = host::nowUs;
+        while (host::nowUs < endUs) {
+            bool full = host::nowUs >= 10 * MIN && host::nowUs < 40 * MIN;
+            world::echoCm[PIN_ECHO_BIO] = full ? 8 : 80;
+            if (gps) world::gpsFeed(host::nowUs + 2 * S);
+            if (host::nowUs >= nextCmd * MIN) {
+                const char* c = command(nextCmd++);
+                if (c) Serial.rxPush(host::nowUs, c);
+            }
+
+            loop();
+
+            // A pass that never reads the clock still costs one tick
+            if (host::nowUs == last) host::advance(host::millisTickUs);
+            uint64_t gap = host::nowUs - last;
+            hist[std::min<uint64_t>(gap / BIN_US, BUCKETS - 1)]++;
+            loops++;
+            sumUs += gap;
+            if (gap > maxUs) maxUs = gap;
+            last = host::nowUs;
+        }
+    } catch (host::Reset &) {
+        printf("reset at %.1f s\n", host::nowUs / 1e6);
+        return 1;
+    }
+
+    // p99: upper edge of the bucket holding the 99th percentile
+    uint64_t seen = 0;
+    uint32_t b    = 0;
+    while (b < BUCKETS - 1 && (seen += hist[b]) * 100 < loops * 99) b++;
+    printf("loops %llu  avg %.2f ms  p99 %.1f ms  max %.1f ms\n", (unsigned long long)loops,
+           sumUs / 1e3 / loops, (b + 1) * BIN_US / 1e3, maxUs / 1e3);
+    return 0;
+}
@@ -0,0 +1,540 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/replay.cpp - feeds a trace back through the unmodified firmware
+ *
+ * Takes a TRACE_RECORD capture (the raw bytes
+ * the PC saved from the bin's Serial TX) and
+ * runs one boot of it through the firmware
+ * built with the same options, then checks
+ * the replay against the field run:
+ *
+ *   inputs   every recorded echo, lux, probe
+ *            and card is asked for, the same
+ *            UART bytes are read from
+ *            GPS/console and SIM800
+ *   outputs  the same lock/SMS STATE sequence
+ *
+ * Each input source (echo per pin, lux, each
+ * probe, cards per reader) is served in its
+ * recorded order: the k-th lux read gets the
+ * k-th recorded lux, and the clock is lined
+ * up with the time it was recorded (sync()).
+ * Before each loop() pass the clock skips
+ * ahead to the next input still to come, so
+ * the time gates (lux, distances, health)
+ * see the field run's millis() and open in
+ * the same pass; passes with nothing to read
+ * are skipped. The replay does not block on
+ * its own TX, so it is never later than the
+ * field run by much; if sources still
+ * interleave differently it counts "order
+ * slips". UART batches are handed over once
+ * the previous one is read and the clock has
+ * reached their time (a SIM800 reply is then
+ * still unread when the simFlush() before
+ * its command runs); cards when the reader
+ * is next polled near theirs.
+ * Time is virtual, so a replay runs as fast
+ * as the host can execute loop().
+ *
+ *   replay                      self-test: record a scenario
+ *                               against the world models, replay it
+ *   replay capture.bin [-b N]   replay boot N (default 1)
+ *
+ * Exit status 1 on any difference.
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <map>
+#include <vector>
+
+#if !TRACE_RECORD
+#error "replay needs TRACE_RECORD"
+#endif
+
+static const uint64_t S  = 1000000ULL;
+static const uint64_t MS = 1000ULL;
+
+static const uint32_t CARD_EARLY_MS = 50;   // half a loop() pass
+static const uint32_t STALL_MS      = 60000;
+
+/* -------------------------------------------
+   RECORDS: trace frames out of a byte stream
+   Text and console replies are skipped.
+   ------------------------------------------- */
+struct Rec {
+    uint8_t              type;
+    uint64_t             ms;                // since boot
+    std::vector<uint8_t> p;                 // payload after dt16
+};
+
+static uint16_t crc16(uint16_t crc, uint8_t b)
+{
+    crc ^= (uint16_t)b << 8;
+    for (uint8_t i = 0; i < 8; i++)
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    return crc;
+}
+
+struct Decoder {
+    std::vector<Rec>     recs;
+    std::vector<uint8_t> seg;
+    uint64_t             ms  = 0;
+    uint32_t             bad = 0;           // segments that are not a frame
+
+    void feed(uint8_t b)
+    {
+        if (b) { seg.push_back(b); return; }
+        if (!seg.empty()) frame();
+        seg.clear();
+    }
+
+    void frame()
+    {
+        std::vector<uint8_t> b;
+        size_t i = 0, n = seg.size();
+        while (i < n) {
+            uint8_t code = seg[i++];
+            if (i + code - 1 > n) { bad++; return; }
+            for (uint8_t k = 1; k < code; k++) b.push_back(seg[i++]);
+            if (code < 0xFF && i < n) b.push_back(0);
+        }
+        if (b.size() < 5) { bad++; return; }
+        uint16_t crc = 0xFFFF;
+        for (size_t k = 0; k + 2 < b.size(); k++) crc = crc16(crc, b[k]);
+        if (crc != (b[b.size() - 2] | (uint16_t)b[b.size() - 1] << 8)) { bad++; return; }
+
+        uint8_t  type = b[0];
+        uint16_t dt   = b[1] | (uint16_t)b[2] << 8;
+        if (type >= 0x80) return;
+        std::vector<uint8_t> p(b.begin() + 3, b.end() - 2);
+        if (type == TR_TIME) {
+            if (p.size() == 4) ms = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+            return;
+        }
+        ms = type == TR_BOOT ? dt : ms + dt;    // first record after a reset
+        recs.push_back(Rec{ type, ms, p });
+    }
+};
+
+static const char* recName(uint8_t t)
+{
+    switch (t) {
+    case TR_BOOT:  return "BOOT";
+    case TR_ECHO:  return "ECHO";
+    case TR_LUX:   return "LUX";
+    case TR_NMEA:  return "NMEA";
+    case TR_CARD:  return "CARD";
+    case TR_MODEM: return "MODEM";
+    case TR_PROBE: return "PROBE";
+    case TR_STATE: return "STATE";
+    case TR_LOOP:  return "LOOP";
+    default:       return "?";
+    }
+}
+
+static bool isInput(uint8_t t) { return t == TR_ECHO || t == TR_LUX || t == TR_PROBE || t == TR_CARD; }
+static int  rxPort(uint8_t t)  { return t == TR_NMEA ? 0 : t == TR_MODEM ? 1 : -1; }
+static uint16_t u16(const std::vector<uint8_t> &p, size_t i) { return p[i] | (uint16_t)p[i + 1] << 8; }
+
+/* -------------------------------------------
+   REPLAY STATE
+   ------------------------------------------- */
+struct Diverged {};
+struct CaptureEnd {};
+
+/* One queue per input source: echo pin, lux, probe id, card reader */
+struct Source {
+    std::vector<size_t> at;                 // indexes into cap
+    size_t              next = 0;
+};
+
+static std::vector<Rec> cap;                // the boot being replayed
+static std::map<uint16_t, Source> srcs;
+static std::vector<bool> used;
+static size_t   firstIn = 0;                // oldest input not used yet
+static size_t   nextRx[2];                  // next NMEA / MODEM batch
+static uint32_t inputsUsed = 0, slips = 0;
+static uint64_t rxUsed[2];
+static uint64_t lateMaxUs = 0;              // replay behind the field run
+static char     why[160];
+static Decoder  out;                        // what the replay writes
+
+static uint16_t srcKey(const Rec &r)        { return r.type << 8 | (r.type == TR_LUX ? 0 : r.p[0]); }
+
+static void skip(size_t &i, int port)
+{
+    while (i < cap.size() && (port < 0 ? !isInput(cap[i].type) || used[i] : rxPort(cap[i].type) != port)) i++;
+}
+
+/* Clock to the recorded time. If the replay is already past it,
+   the clock stands still for that long instead (host::slackUs):
+   waits in progress keep measuring forward, and the next time
+   gate is judged against the field run's clock. */
+static void sync(uint64_t ms)
+{
+    uint64_t at = ms * MS;
+    host::slackUs = 0;
+    if (host::nowUs < at) {
+        host::advance(at - host::nowUs);
+        return;
+    }
+    host::slackUs = host::nowUs - at;
+    if (host::slackUs > lateMaxUs) lateMaxUs = host::slackUs;
+}
+
+static const Rec& take(uint8_t type, uint8_t id)
+{
+    auto it = srcs.find(type << 8 | id);
+    if (it == srcs.end()) {
+        snprintf(why, sizeof(why), "at %.3f s the firmware read %s %u, which the capture never has",
+                 host::nowUs / 1e6, recName(type), id);
+        throw Diverged();
+    }
+    Source &s = it->second;
+    if (s.next == s.at.size()) throw CaptureEnd();
+    size_t i = s.at[s.next++];
+    if (i != firstIn) slips++;
+    used[i] = true;
+    skip(firstIn, -1);
+    inputsUsed++;
+    return cap[i];
+}
+
+/* -------------------------------------------
+   HOOKS: pulled inputs
+   ------------------------------------------- */
+static unsigned long rpPulseIn(uint8_t pin, unsigned long timeoutUs)
+{
+    const Rec &r = take(TR_ECHO, pin);
+    unsigned long us = u16(r.p, 1);
+    sync(r.ms);                             // stamped when the pulse started
+    host::advance(us ? us : timeoutUs);
+    return us;
+}
+
+static float rpLux()
+{
+    const Rec &r = take(TR_LUX, 0);
+    float lux;
+    memcpy(&lux, r.p.data(), 4);
+    sync(r.ms);
+    return lux;
+}
+
+static uint8_t rpProbe(uint8_t id)
+{
+    const Rec &r = take(TR_PROBE, id);
+    sync(r.ms);
+    return r.p[1];
+}
+
+static bool    rpLuxBegin()             { return rpProbe(PROBE_BH1750); }
+static uint8_t rpI2c(uint8_t addr)      { return rpProbe(addr); }
+static uint8_t rpRfidVersion(uint8_t ss) { return rpProbe(PROBE_SPI | ss); }
+
+/* -------------------------------------------
+   HOOKS: pushed inputs
+   ------------------------------------------- */
+static bool rpCard(uint8_t ss, uint8_t* uid, uint8_t* size)
+{
+    uint8_t reader = ss == PIN_RFID_BIO_SS ? 0 : 1;
+    auto    it     = srcs.find(TR_CARD << 8 | reader);
+    if (it == srcs.end() || it->second.next == it->second.at.size()) return false;
+    if (host::nowUs + CARD_EARLY_MS * MS < cap[it->second.at[it->second.next]].ms * MS) return false;
+    const Rec &r = take(TR_CARD, reader);
+    *size = (uint8_t)(r.p.size() - 1);
+    memcpy(uid, r.p.data() + 1, *size);
+    sync(r.ms);
+    return true;
+}
+
+static void rpFeed(HostUart &u)
+{
+    int     port = &u == &Serial ? 0 : 1;
+    size_t &i    = nextRx[port];
+    if (i >= cap.size() || !u.rxIdle() || host::nowUs < cap[i].ms * MS) return;
+    for (uint8_t b : cap[i].p) u.rxPush(host::nowUs, b);
+    host::slackUs += cap[i].p.size() * host::millisTickUs;    // read before now in the field run
+    rxUsed[port] += cap[i].p.size();
+    i++;
+    skip(i, port);
+}
+
+static void rpTx(uint64_t, uint8_t b) { out.feed(b); }
+
+/* -------------------------------------------
+   COMPARE
+   ------------------------------------------- */
+static std::vector<const Rec*> only(const std::vector<Rec> &v, bool (*want)(uint8_t))
+{
+    std::vector<const Rec*> r;
+    for (const Rec &x : v) if (want(x.type)) r.push_back(&x);
+    return r;
+}
+
+static bool isState(uint8_t t) { return t == TR_STATE; }
+
+static std::vector<uint8_t> rxBytes(const std::vector<Rec> &v, int port)
+{
+    std::vector<uint8_t> r;
+    for (const Rec &x : v) if (rxPort(x.type) == port) r.insert(r.end(), x.p.begin(), x.p.end());
+    return r;
+}
+
+static bool prefix(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+{
+    return a.size() <= b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+/* -------------------------------------------
+   REPLAY ONE BOOT
+   ------------------------------------------- */
+static int replay(const std::vector<Rec> &all, uint32_t bad, int bootNo)
+{
+    int    boots = 0;
+    size_t b0 = all.size(), b1 = all.size();
+    for (size_t i = 0; i < all.size(); i++) {
+        if (all[i].type != TR_BOOT) continue;
+        if (++boots == bootNo)         b0 = i;
+        else if (boots == bootNo + 1)  b1 = i;
+    }
+    if (b0 == all.size()) { printf("no boot %d in the capture (%d boots)\n", bootNo, boots); return 1; }
+    cap.assign(all.begin() + b0, all.begin() + b1);
+
+    const std::vector<uint8_t> &bp = cap[0].p;
+    if (bp.size() != 10 + 5 * BIN_COUNT || bp[0] != TRACE_VERSION || u16(bp, 1) != TRACE_CONFIG) {
+        printf("capture is trace v%u config %04X, this build replays v%u config %04X\n",
+               bp[0], bp.size() > 2 ? u16(bp, 1) : 0, TRACE_VERSION, TRACE_CONFIG);
+        return 1;
+    }
+
+    uint32_t count[0x80] = {};
+    for (const Rec &r : cap) count[r.type]++;
+    uint64_t endMs = cap.back().ms;
+    printf("capture: boot %d of %d, device %u, %s, %.1f s, %zu records (",
+           bootNo, boots, u16(bp, 3), bp[5] ? "warm" : "cold", endMs / 1e3, cap.size());
+    for (int t = 0; t < 0x80; t++) if (count[t]) printf(" %s %u", recName(t), count[t]);
+    printf(" ), %u bad frames\n", bad);
+
+    // Start from the recorded state: warm-reset RAM, SMS log, calibration
+    EEPROM.write(EE_SMS_LOG,      bp[8]);
+    EEPROM.write(EE_SMS_LOG_HEAD, bp[9]);
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        BinState &b = *dev->bins[i];
+        b.depthCm = u16(bp, 11 + 5 * i);
+        b.fullCm  = u16(bp, 13 + 5 * i);
+        b.emptyCm = b.fullCm + b.hystCm;
+        if (bp[5]) {
+            b.locked   = bp[6] & (1 << i);
+            b.smsCount = bp[10 + 5 * i];
+        }
+    }
+    if (bp[5]) {
+        healthReboots = bp[7];
+        persistSave();
+    }
+
+    host::millisTickUs = 10;
+    host::pulseIn      = rpPulseIn;
+    host::lux          = rpLux;
+    host::luxBegin     = rpLuxBegin;
+    host::i2c          = rpI2c;
+    host::rfidVersion  = rpRfidVersion;
+    host::card         = rpCard;
+    Serial.rxFeed      = rpFeed;
+#if USE_MODEM
+    sim800.rxFeed      = rpFeed;
+#endif
+    Serial.txHook      = rpTx;
+    Serial.txFree      = true;              // its time is in the recorded stamps
+    used.assign(cap.size(), false);
+    for (size_t i = 0; i < cap.size(); i++) if (isInput(cap[i].type)) srcs[srcKey(cap[i])].at.push_back(i);
+    for (int p = 0; p < 2; p++) { nextRx[p] = 0; skip(nextRx[p], p); }
+    skip(firstIn, -1);
+
+    const char* stop = "end of capture";
+    clock_t     c0   = clock();
+    try {
+        setup();
+        while (true) {
+            bool done = firstIn >= cap.size() && nextRx[0] >= cap.size() && nextRx[1] >= cap.size() &&
+                        Serial.rxIdle();
+#if USE_MODEM
+            done = done && sim800.rxIdle();
+#endif
+            if (done && host::nowUs >= endMs * MS) break;
+            if (host::nowUs >= (endMs + STALL_MS) * MS) { stop = "stalled"; break; }
+            if (firstIn < cap.size() && host::nowUs < cap[firstIn].ms * MS) {
+                host::slackUs = 0;
+                host::advance(cap[firstIn].ms * MS - host::nowUs);
+            }
+            loop();
+        }
+    } catch (CaptureEnd &) {
+    } catch (Diverged &) {
+        stop = why;
+    } catch (host::Reset &) {
+        stop = "watchdog reset";
+    }
+    traceFlush();
+    double wall = (double)(clock() - c0) / CLOCKS_PER_SEC;
+
+    // Field run vs replay
+    bool same = !strcmp(stop, "end of capture");
+    std::vector<const Rec*> ci = only(cap, isInput), ri = only(out.recs, isInput);
+    std::vector<const Rec*> cs = only(cap, isState), rs = only(out.recs, isState);
+    std::map<uint16_t, std::vector<const Rec*> > rIn;
+    for (const Rec* r : ri) rIn[srcKey(*r)].push_back(r);
+    const Rec* inBad = 0;                   // first read that differs from its source
+    for (auto &k : rIn) {
+        auto it = srcs.find(k.first);
+        for (size_t n = 0; n < k.second.size() && !inBad; n++)
+            if (it == srcs.end() || n >= it->second.at.size() || cap[it->second.at[n]].p != k.second[n]->p)
+                inBad = k.second[n];
+    }
+    same = same && !inBad && ri.size() == inputsUsed && !out.recs.empty() && out.recs[0].p == bp;
+
+    uint64_t rxTotal[2];
+    for (int p = 0; p < 2; p++) {
+        std::vector<uint8_t> c = rxBytes(cap, p), r = rxBytes(out.recs, p);
+        rxTotal[p] = c.size();
+        same = same && prefix(r, c) && r.size() == rxUsed[p];
+    }
+
+    uint64_t skewMs = 0;
+    size_t   stSame = 0;
+    while (stSame < rs.size() && stSame < cs.size() && rs[stSame]->p == cs[stSame]->p) {
+        uint64_t a = rs[stSame]->ms, c = cs[stSame]->ms;
+        if ((a > c ? a - c : c - a) > skewMs) skewMs = a > c ? a - c : c - a;
+        stSame++;
+    }
+    same = same && stSame == cs.size() && rs.size() == cs.size();
+
+    printf("inputs:  %u/%zu echo/lux/probe/card, Serial %llu/%llu B, SIM800 %llu/%llu B, %u order slips\n",
+           inputsUsed, ci.size(), (unsigned long long)rxUsed[0], (unsigned long long)rxTotal[0],
+           (unsigned long long)rxUsed[1], (unsigned long long)rxTotal[1], slips);
+
+    printf("decisions (field run):\n");
+    uint8_t  flags = bp[5] ? bp[6] : 0;
+    uint16_t sms   = 0;
+    for (const Rec* r : cs) {
+        if (r->p[0] == flags && u16(r->p, 1) == sms) continue;   // first one after boot
+        printf("  %8.1f s ", r->ms / 1e3);
+        for (uint8_t i = 0; i < BIN_COUNT; i++)
+            if ((r->p[0] ^ flags) & (1 << i))
+                printf(" %s %s", dev->bins[i]->label, r->p[0] & (1 << i) ? "locked" : "unlocked");
+        if (u16(r->p, 1) != sms) printf(" SMS sent: %u", u16(r->p, 1));
+        printf("\n");
+        flags = r->p[0];
+        sms   = u16(r->p, 1);
+    }
+    printf("SMS sent: %u\n", sms);
+
+    uint32_t loops = 0, lmin = 0xFFFF, lmax = 0;
+    uint64_t lsum  = 0;
+    for (const Rec &r : cap) {
+        if (r.type != TR_LOOP) continue;
+        loops += u16(r.p, 0);
+        lsum  += (uint64_t)u16(r.p, 0) * u16(r.p, 4);
+        if (u16(r.p, 2) < lmin) lmin = u16(r.p, 2);
+        if (u16(r.p, 6) > lmax) lmax = u16(r.p, 6);
+    }
+    if (loops) printf("field loop body: %u passes, min/avg/max %u/%.0f/%u ms\n", loops, lmin, (double)lsum / loops, lmax);
+
+    printf("replay:  %.1f s in %.2f s wall (%.0fx real time), up to %.0f ms behind, states %.0f ms apart\n",
+           host::nowUs / 1e6, wall, wall > 0 ? host::nowUs / 1e6 / wall : 0.0, lateMaxUs / 1e3, (double)skewMs);
+    printf("stopped: %s\n", stop);
+    if (stSame < cs.size() || rs.size() != cs.size())
+        printf("STATE %zu differs: field %zu records, replay %zu\n", stSame + 1, cs.size(), rs.size());
+    if (inBad)
+        printf("input differs: %s at %.3f s\n", recName(inBad->type), inBad->ms / 1e3);
+    printf("result:  %s\n", same ? "identical" : "DIFFERENT");
+    return same ? 0 : 1;
+}
+
+/* -------------------------------------------
+   SELF-TEST: one field run against the world
+   models (child process), captured as the PC
+   would save it
+   ------------------------------------------- */
+static FILE* capFile;
+
+static void capTx(uint64_t, uint8_t b) { fputc(b, capFile); }
+
+static bool fieldCard(uint8_t ss, uint8_t* uid, uint8_t* size)
+{
+    static bool shown = false;
+    if (shown || ss != PIN_RFID_BIO_SS || host::nowUs < 120 * S) return false;
+    static const uint8_t AUTH[] = { 0x43, 0xFE, 0xB5, 0x38 };
+    shown = true;
+    memcpy(uid, AUTH, sizeof(AUTH));
+    *size = sizeof(AUTH);
+    return true;
+}
+
+static float fieldLux() { return host::nowUs % (200 * S) < 100 * S ? 320.0f : 12.0f; }
+
+static void record(const char* path)
+{
+    capFile = fopen(path, "wb");
+    if (!capFile) { perror(path); _exit(1); }
+    Serial.txHook      = capTx;
+    host::millisTickUs = 10;
+    host::card         = fieldCard;
+    host::lux          = fieldLux;
+    world::modemAttach();
+    world::echoAttach();
+    world::gpsFeed(2 * S);
+
+    setup();
+    while (host::nowUs < 400 * S) {
+        uint64_t t = host::nowUs;
+        world::modemUp = t < 150 * S || t >= 260 * S;       // outage
+        world::echoCm[PIN_ECHO_BIO] = t >= 60 * S && t < 125 * S ? 5 : 80;
+        world::echoCm[PIN_ECHO_NON] = t >= 180 * S ? 5 : 40; // fills during the outage
+        world::gpsFeed(t + 2 * S);
+        loop();
+    }
+    traceFlush();
+    fclose(capFile);
+    _exit(0);
+}
+
+/* -------------------------------------------
+   MAIN
+   ------------------------------------------- */
+int main(int argc, char** argv)
+{
+    setvbuf(stdout, 0, _IONBF, 0);
+    char        tmp[] = "/tmp/replay_XXXXXX";
+    const char* path  = argc > 1 ? argv[1] : tmp;
+    int         bootNo = argc > 3 && !strcmp(argv[2], "-b") ? atoi(argv[3]) : 1;
+
+    if (argc < 2) {
+        int fd = mkstemp(tmp);
+        if (fd < 0) { perror("mkstemp"); return 1; }
+        close(fd);
+        printf("self-test: 400 s field run, BIO full 60-125 s, card at 120 s, "
+               "modem down 150-260 s, NON-BIO full from 180 s\n");
+        pid_t pid = fork();
+        if (pid == 0) record(tmp);
+        int st;
+        waitpid(pid, &st, 0);
+        if (!WIFEXITED(st) || WEXITSTATUS(st)) { printf("field run failed\n"); return 1; }
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (!f) { perror(path); return 1; }
+    Decoder in;
+    for (int c; (c = fgetc(f)) != EOF; ) in.feed((uint8_t)c);
+    in.feed(0);
+    fclose(f);
+    if (argc < 2) unlink(tmp);
+
+    return replay(in.recs, in.bad, bootNo);
+}
@@ -0,0 +1,249 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/Arduino.h - Arduino core for host builds
+ *
+ * Just enough of the AVR core to compile the
+ * firmware unmodified on a PC. Time is virtual
+ * (host::nowUs); the UARTs model their RX/TX
+ * buffers at the configured baud rate so
+ * overruns and blocking writes show up the
+ * same way they would on the Uno.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <deque>
+
+/* -------------------------------------------
+   CORE TYPES / CONSTANTS
+   ------------------------------------------- */
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH                0x1
+#define LOW                 0x0
+#define INPUT               0x0
+#define OUTPUT              0x1
+#define INPUT_PULLUP        0x2
+
+#define DEC                 10
+#define HEX                 16
+
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+
+#define PROGMEM
+#define PSTR(s)             (s)
+class __FlashStringHelper;
+#define F(s)                (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+/* -------------------------------------------
+   HOST HOOKS
+   Set by the driver. Defaults model a bench
+   with every peripheral present and silent.
+   ------------------------------------------- */
+namespace host {
+    struct Reset {};                            // thrown when the watchdog fires
+
+    extern thread_local uint64_t nowUs;         // virtual clock
+    extern thread_local uint32_t millisTickUs;  // added per millis()/micros() call
+    extern thread_local uint64_t slackUs;       // used up by advance() before the clock
+                                                // moves (a replay catching up)
+
+    void     advance(uint64_t us);              // moves the clock, runs the watchdog
+    void     wdtSet(bool on, uint32_t timeoutMs);
+    void     wdtKick();
+    bool     wdtRunning();
+    void     wdtFire();                         // reset now (after 16ms)
+
+    extern unsigned long (*pulseIn)(uint8_t pin, unsigned long timeoutUs);
+    extern bool          (*luxBegin)();
+    extern float         (*lux)();
+    extern bool          (*card)(uint8_t ss, uint8_t* uid, uint8_t* size);
+    extern uint8_t       (*rfidVersion)(uint8_t ss);
+    extern uint8_t       (*i2c)(uint8_t addr);  // Wire.endTransmission() result
+}
+
+/* -------------------------------------------
+   TIME / GPIO
+   ------------------------------------------- */
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t val);
+int           digitalRead(uint8_t pin);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeoutUs = 1000000UL);
+void          tone(uint8_t pin, unsigned int freq, unsigned long durationMs = 0);
+void          noTone(uint8_t pin);
+
+void          setup();
+void          loop();
+
+/* -------------------------------------------
+   STRING
+   ------------------------------------------- */
+class String {
+public:
+    String(const char* s = "")                  : s_(s ? s : "") {}
+    String(const __FlashStringHelper* s)        : s_((const char*)s) {}
+    String(const std::string &s)                : s_(s) {}
+    explicit String(char c)                     : s_(1, c) {}
+    String(unsigned char v, unsigned char base = DEC) { num(v, base); }
+    String(int v, unsigned char base = DEC)           { num(v, base); }
+    String(unsigned int v, unsigned char base = DEC)  { num(v, base); }
+    String(long v, unsigned char base = DEC)          { num(v, base); }
+    String(unsigned long v, unsigned char base = DEC) { num(v, base); }
+    String(double v, unsigned char digits = 2);
+
+    unsigned int length() const                 { return (unsigned int)s_.size(); }
+    const char*  c_str() const                  { return s_.c_str(); }
+    char         charAt(unsigned int i) const   { return i < s_.size() ? s_[i] : 0; }
+    char         operator[](unsigned int i) const { return charAt(i); }
+
+    String& operator+=(const String &o)         { s_ += o.s_; return *this; }
+    String& operator+=(const char* o)           { s_ += o; return *this; }
+    String& operator+=(const __FlashStringHelper* o) { s_ += (const char*)o; return *this; }
+    String& operator+=(char c)                  { s_ += c; return *this; }
+    String& operator+=(unsigned char v)         { return *this += String(v); }
+    String& operator+=(int v)                   { return *this += String(v); }
+    String& operator+=(unsigned int v)          { return *this += String(v); }
+    String& operator+=(long v)                  { return *this += String(v); }
+    String& operator+=(unsigned long v)         { return *this += String(v); }
+    String& operator+=(double v)                { return *this += String(v); }
+
+    friend String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+    friend String operator+(const String &a, const char* b)   { String r(a); r += b; return r; }
+    friend String operator+(const String &a, const __FlashStringHelper* b) { String r(a); r += b; return r; }
+
+    bool operator==(const String &o) const      { return s_ == o.s_; }
+    bool operator==(const char* o) const        { return s_ == o; }
+    bool operator==(const __FlashStringHelper* o) const { return s_ == (const char*)o; }
+    bool operator!=(const String &o) const      { return s_ != o.s_; }
+
+    int    indexOf(char c, unsigned int from = 0) const;
+    int    indexOf(const String &o, unsigned int from = 0) const;
+    String substring(unsigned int from) const   { return substring(from, length()); }
+    String substring(unsigned int from, unsigned int to) const;
+    long   toInt() const                        { return atol(s_.c_str()); }
+    void   trim();
+    void   toUpperCase();
+    bool   equalsIgnoreCase(const String &o) const;
+    bool   startsWith(const String &o) const    { return s_.compare(0, o.s_.size(), o.s_) == 0; }
+
+private:
+    void num(unsigned long v, unsigned char base);
+    void num(long v, unsigned char base);
+    void num(int v, unsigned char base)         { num((long)v, base); }
+    void num(unsigned int v, unsigned char base) { num((unsigned long)v, base); }
+    void num(unsigned char v, unsigned char base) { num((unsigned long)v, base); }
+    std::string s_;
+};
+
+/* -------------------------------------------
+   PRINT / STREAM
+   ------------------------------------------- */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* p, size_t n);
+    size_t write(const char* s)                 { return write((const uint8_t*)s, strlen(s)); }
+
+    size_t print(const char* s)                 { return write(s); }
+    size_t print(const String &s)               { return write(s.c_str()); }
+    size_t print(const __FlashStringHelper* s)  { return write((const char*)s); }
+    size_t print(char c)                        { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC)  { return print(String(v, base)); }
+    size_t print(int v, int base = DEC)            { return print(String(v, base)); }
+    size_t print(unsigned int v, int base = DEC)   { return print(String(v, base)); }
+    size_t print(long v, int base = DEC)           { return print(String(v, base)); }
+    size_t print(unsigned long v, int base = DEC)  { return print(String(v, base)); }
+    size_t print(double v, int digits = 2)         { return print(String(v, digits)); }
+    size_t println()                            { return write("\r\n"); }
+    template<class T> size_t println(const T &v)          { size_t n = print(v); return n + println(); }
+    template<class T> size_t println(const T &v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    String readStringUntil(char term);
+    void   setTimeout(unsigned long ms)         { timeoutMs_ = ms; }
+protected:
+    unsigned long timeoutMs_ = 1000;
+};
+
+/* -------------------------------------------
+   UART MODEL
+   RX: bytes pushed with an arrival time land
+   in a 63-byte buffer; arrivals while it is
+   full are lost (overruns). Two senders can
+   share the line (rxWired()). TX: bytes leave
+   at the baud rate through a 63-byte buffer
+   (write blocks when full) or, bit-banged,
+   block for the whole byte (SoftwareSerial).
+   ------------------------------------------- */
+class HostUart : public Stream {
+public:
+    explicit HostUart(bool bitBang) : bitBang_(bitBang) {}
+
+    void   begin(unsigned long baud)            { byteUs_ = 10000000UL / baud; }
+    void   end()                                {}
+    int    available() override;
+    int    read() override;
+    int    peek() override;
+    void   flush();
+    size_t write(uint8_t b) override;
+    using  Print::write;
+    operator bool() const                       { return true; }
+
+    // host side
+    void     rxPush(uint64_t atUs, uint8_t b);  // in time order with earlier pushes
+    void     rxPush(uint64_t atUs, const char* s);
+    bool     rxWired(uint64_t atUs, uint8_t b); // second transmitter on the line: a
+                                                // byte overlapping a pending one ANDs
+                                                // into it (true = collision)
+    uint64_t rxTail() const                     { return pending_.empty() ? 0 : pending_.back().at; }
+    bool     rxIdle() const                     { return pending_.empty() && rx_.empty(); }
+    void     rxClear()                          { pending_.clear(); rx_.clear(); }  // next board on the line
+    void   (*rxFeed)(HostUart &u) = 0;          // called before every available/read/peek
+    uint32_t byteUs() const                     { return byteUs_; }
+    void   (*txHook)(uint64_t atUs, uint8_t b) = 0;   // byte leaves the pin at atUs
+    bool     txFree   = false;                  // TX takes no time (a replay's own trace)
+    uint32_t overruns = 0;
+    uint32_t rxHigh   = 0;                      // most bytes buffered at once
+
+private:
+    struct Rx { uint64_t at; uint8_t b; };
+    void pump();
+    bool                bitBang_;
+    uint32_t            byteUs_ = 1042;         // 9600 baud
+    std::deque<Rx>      pending_;
+    std::deque<uint8_t> rx_;
+    uint64_t            txDoneUs_ = 0;
+};
+
+class HardwareSerial : public HostUart {
+public:
+    HardwareSerial() : HostUart(false) {}
+};
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,18 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/BH1750.h - readings from host::lux
+ */
+
+#ifndef HOST_BH1750_H
+#define HOST_BH1750_H
+
+#include <Arduino.h>
+
+class BH1750 {
+public:
+    enum Mode { CONTINUOUS_HIGH_RES_MODE = 0x10 };
+    bool  begin(Mode = CONTINUOUS_HIGH_RES_MODE) { return host::luxBegin(); }
+    float readLightLevel()                      { return host::lux(); }
+};
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/EEPROM.h - 1 KB EEPROM, erased (0xFF)
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+class EEPROMClass {
+public:
+    EEPROMClass()                               { erase(); }
+    uint8_t  read(int a)                        { return mem[a & 0x3FF]; }
+    void     write(int a, uint8_t v)            { mem[a & 0x3FF] = v; writes++; }
+    void     update(int a, uint8_t v)           { if (read(a) != v) write(a, v); }
+    uint16_t length()                           { return sizeof(mem); }
+    template<class T> T& get(int a, T &t)       { memcpy(&t, mem + a, sizeof(T)); return t; }
+    template<class T> const T& put(int a, const T &t)
+    {
+        const uint8_t* p = (const uint8_t*)&t;
+        for (size_t i = 0; i < sizeof(T); i++) update(a + (int)i, p[i]);
+        return t;
+    }
+
+    // host side
+    void     erase()                            { memset(mem, 0xFF, sizeof(mem)); }
+    uint8_t  mem[1024];
+    uint32_t writes = 0;                        // cells actually written (wear)
+};
+extern EEPROMClass EEPROM;
+
+#endif
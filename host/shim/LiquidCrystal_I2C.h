@@ -0,0 +1,25 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/LiquidCrystal_I2C.h - 16x2 text buffer
+ */
+
+#ifndef HOST_LCD_H
+#define HOST_LCD_H
+
+#include <Arduino.h>
+
+class LiquidCrystal_I2C : public Print {
+public:
+    LiquidCrystal_I2C(uint8_t addr, uint8_t cols, uint8_t rows) : addr_(addr) { (void)cols; (void)rows; clear(); }
+    void   init()                               {}
+    void   backlight()                          {}
+    void   clear()                              { memset(text, ' ', sizeof(text)); col_ = row_ = 0; }
+    void   setCursor(uint8_t c, uint8_t r)      { col_ = c; row_ = r & 1; }
+    size_t write(uint8_t b) override            { if (col_ < 16) text[row_][col_++] = (char)b; return 1; }
+    using  Print::write;
+    char   text[2][16];
+private:
+    uint8_t addr_, col_, row_;
+};
+
+#endif
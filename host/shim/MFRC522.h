@@ -0,0 +1,28 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/MFRC522.h - cards from host::card
+ */
+
+#ifndef HOST_MFRC522_H
+#define HOST_MFRC522_H
+
+#include <Arduino.h>
+
+class MFRC522 {
+public:
+    enum PCD_Register { VersionReg = 0x37 << 1 };
+    struct Uid { uint8_t size; uint8_t uidByte[10]; uint8_t sak; };
+
+    MFRC522(uint8_t ss, uint8_t rst) : ss_(ss)  { (void)rst; uid.size = 0; }
+    void    PCD_Init()                          {}
+    uint8_t PCD_ReadRegister(PCD_Register)      { return host::rfidVersion(ss_); }
+    bool    PICC_IsNewCardPresent()             { return host::card(ss_, uid.uidByte, &uid.size); }
+    bool    PICC_ReadCardSerial()               { return uid.size > 0; }
+    void    PICC_HaltA()                        {}
+    void    PCD_StopCrypto1()                   {}
+    Uid     uid;
+private:
+    uint8_t ss_;
+};
+
+#endif
@@ -0,0 +1,15 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/SPI.h
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+class SPIClass {
+public:
+    void begin() {}
+};
+extern SPIClass SPI;
+
+#endif
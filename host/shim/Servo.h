@@ -0,0 +1,23 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/Servo.h - remembers the last angle
+ */
+
+#ifndef HOST_SERVO_H
+#define HOST_SERVO_H
+
+#include <Arduino.h>
+
+class Servo {
+public:
+    uint8_t attach(int pin)                     { pin_ = pin; return 1; }
+    void    write(int deg)                      { angle = deg; moves++; if (onWrite) onWrite(*this, deg); }
+    int     read()                              { return angle; }
+    int      angle = 0;
+    uint32_t moves = 0;
+    static void (*onWrite)(Servo &s, int deg);  // driver hook, every write
+private:
+    int pin_ = -1;
+};
+
+#endif
@@ -0,0 +1,16 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/SoftwareSerial.h - bit-banged UART model
+ */
+
+#ifndef HOST_SOFTWARESERIAL_H
+#define HOST_SOFTWARESERIAL_H
+
+#include <Arduino.h>
+
+class SoftwareSerial : public HostUart {
+public:
+    SoftwareSerial(uint8_t rx, uint8_t tx) : HostUart(true) { (void)rx; (void)tx; }
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/TinyGPS++.h - NMEA framing and checksum only
+ *
+ * Counts characters and checks each sentence's
+ * *hh checksum like TinyGPS++ does, so lost UART
+ * bytes show up as failedChecksum(). Positions
+ * are never decoded: location is never valid.
+ */
+
+#ifndef HOST_TINYGPS_H
+#define HOST_TINYGPS_H
+
+#include <Arduino.h>
+
+struct TinyGPSLocation {
+    bool   isValid() const                      { return false; }
+    double lat() const                          { return 0.0; }
+    double lng() const                          { return 0.0; }
+};
+struct TinyGPSInteger  { uint32_t value() const { return 0; } };
+struct TinyGPSAltitude {
+    bool   isValid() const                      { return false; }
+    double meters() const                       { return 0.0; }
+};
+
+class TinyGPSPlus {
+public:
+    bool encode(char c);
+    uint32_t charsProcessed() const             { return chars_; }
+    uint32_t passedChecksum() const             { return passed_; }
+    uint32_t failedChecksum() const             { return failed_; }
+    TinyGPSLocation location;
+    TinyGPSInteger  satellites;
+    TinyGPSAltitude altitude;
+private:
+    uint32_t chars_ = 0, passed_ = 0, failed_ = 0;
+    uint8_t  sum_ = 0, got_ = 0, hex_ = 0;
+    int8_t   state_ = 0;                        // 0 idle, 1 body, 2/3 checksum digits
+};
+
+inline bool TinyGPSPlus::encode(char c)
+{
+    chars_++;
+    if (c == '$') { state_ = 1; sum_ = 0; return false; }
+    if (state_ == 1) {
+        if (c == '*')                    { state_ = 2; got_ = 0; hex_ = 0; }
+        else if (c == '\r' || c == '\n') { state_ = 0; failed_++; }
+        else                             sum_ ^= (uint8_t)c;
+        return false;
+    }
+    if (state_ >= 2) {
+        int v = (c >= '0' && c <= '9') ? c - '0' : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (v < 0) { state_ = 0; failed_++; return false; }
+        hex_ = (uint8_t)(hex_ << 4 | v);
+        if (++state_ == 4) {
+            state_ = 0;
+            if (hex_ == sum_) { passed_++; return true; }
+            failed_++;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/Wire.h - I2C bus, acks from host::i2c
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+#define WIRE_HAS_TIMEOUT
+
+class TwoWire {
+public:
+    void    begin()                             {}
+    void    setWireTimeout(uint32_t, bool)      {}
+    void    beginTransmission(uint8_t addr)     { addr_ = addr; }
+    uint8_t endTransmission()                   { return host::i2c(addr_); }
+private:
+    uint8_t addr_ = 0;
+};
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/arduino.cpp - Arduino core for host builds
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "Servo.h"
+#include "avr/io.h"
+#include <stdio.h>
+#include <ctype.h>
+
+uint8_t MCUSR = 0;
+
+/* -------------------------------------------
+   HOST HOOK DEFAULTS
+   ------------------------------------------- */
+namespace host {
+    thread_local uint64_t nowUs        = 0;
+    thread_local uint32_t millisTickUs = 0;
+    thread_local uint64_t slackUs      = 0;
+
+    static unsigned long defPulseIn(uint8_t, unsigned long t) { advance(t); return 0; }
+    static bool    defLuxBegin()                    { return true; }
+    static float   defLux()                         { return 100.0f; }
+    static bool    defCard(uint8_t, uint8_t*, uint8_t*) { return false; }
+    static uint8_t defRfidVersion(uint8_t)          { return 0x92; }
+    static uint8_t defI2c(uint8_t)                  { return 0; }
+
+    unsigned long (*pulseIn)(uint8_t, unsigned long)      = defPulseIn;
+    bool          (*luxBegin)()                           = defLuxBegin;
+    float         (*lux)()                                = defLux;
+    bool          (*card)(uint8_t, uint8_t*, uint8_t*)    = defCard;
+    uint8_t       (*rfidVersion)(uint8_t)                 = defRfidVersion;
+    uint8_t       (*i2c)(uint8_t)                         = defI2c;
+
+    static thread_local bool     wdtOn     = false;
+    static thread_local uint32_t wdtMs     = 0;
+    static thread_local uint64_t wdtKickUs = 0;
+
+    // A watchdog reset leaves WDRF set and the watchdog running at
+    // 16ms; wdt_disable() has no effect until MCUSR is cleared.
+    void advance(uint64_t us)
+    {
+        uint64_t s = us < slackUs ? us : slackUs;
+        slackUs -= s;
+        nowUs   += us - s;
+        if (wdtOn && nowUs - wdtKickUs >= (uint64_t)wdtMs * 1000ULL) {
+            nowUs     = wdtKickUs + (uint64_t)wdtMs * 1000ULL;
+            MCUSR    |= 1 << WDRF;
+            wdtMs     = 16;
+            wdtKickUs = nowUs;
+            throw Reset();
+        }
+    }
+
+    void wdtSet(bool on, uint32_t timeoutMs)
+    {
+        if (!on && (MCUSR & (1 << WDRF))) return;
+        wdtOn     = on;
+        wdtMs     = timeoutMs;
+        wdtKickUs = nowUs;
+    }
+
+    bool wdtRunning() { return wdtOn; }
+
+    void wdtFire()
+    {
+        wdtSet(true, 16);
+        advance(16000);
+    }
+
+    void wdtKick() { wdtKickUs = nowUs; }
+}
+
+/* -------------------------------------------
+   TIME / GPIO
+   ------------------------------------------- */
+unsigned long millis()
+{
+    host::advance(host::millisTickUs);
+    return (unsigned long)(uint32_t)(host::nowUs / 1000ULL);
+}
+
+unsigned long micros()
+{
+    host::advance(host::millisTickUs);
+    return (unsigned long)(uint32_t)host::nowUs;
+}
+
+void delay(unsigned long ms)                { host::advance((uint64_t)ms * 1000ULL); }
+void delayMicroseconds(unsigned int us)     { host::advance(us); }
+void pinMode(uint8_t, uint8_t)              {}
+void digitalWrite(uint8_t, uint8_t)         {}
+int  digitalRead(uint8_t)                   { return LOW; }
+void tone(uint8_t, unsigned int, unsigned long) {}
+void noTone(uint8_t)                        {}
+
+unsigned long pulseIn(uint8_t pin, uint8_t, unsigned long timeoutUs)
+{
+    return host::pulseIn(pin, timeoutUs);
+}
+
+/* -------------------------------------------
+   STRING
+   ------------------------------------------- */
+String::String(double v, unsigned char digits)
+{
+    char b[40];
+    snprintf(b, sizeof(b), "%.*f", digits, v);
+    s_ = b;
+}
+
+void String::num(unsigned long v, unsigned char base)
+{
+    char b[40];
+    snprintf(b, sizeof(b), base == HEX ? "%lx" : "%lu", v);
+    s_ = b;
+}
+
+void String::num(long v, unsigned char base)
+{
+    if (base != DEC) { num((unsigned long)v, base); return; }
+    char b[40];
+    snprintf(b, sizeof(b), "%ld", v);
+    s_ = b;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t i = s_.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String &o, unsigned int from) const
+{
+    size_t i = s_.find(o.s_, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to) { unsigned int t = from; from = to; to = t; }
+    if (from >= s_.size()) return String();
+    return String(s_.substr(from, to - from));
+}
+
+void String::trim()
+{
+    size_t a = s_.find_first_not_of(" \t\r\n");
+    size_t b = s_.find_last_not_of(" \t\r\n");
+    s_ = (a == std::string::npos) ? std::string() : s_.substr(a, b - a + 1);
+}
+
+void String::toUpperCase()
+{
+    for (size_t i = 0; i < s_.size(); i++) s_[i] = (char)toupper((unsigned char)s_[i]);
+}
+
+bool String::equalsIgnoreCase(const String &o) const
+{
+    if (s_.size() != o.s_.size()) return false;
+    for (size_t i = 0; i < s_.size(); i++)
+        if (toupper((unsigned char)s_[i]) != toupper((unsigned char)o.s_[i])) return false;
+    return true;
+}
+
+/* -------------------------------------------
+   PRINT / STREAM
+   ------------------------------------------- */
+size_t Print::write(const uint8_t* p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) write(p[i]);
+    return n;
+}
+
+String Stream::readStringUntil(char term)
+{
+    std::string s;
+    unsigned long t0 = millis();
+    while (millis() - t0 < timeoutMs_) {
+        if (!available()) { host::advance(100); continue; }
+        int c = read();
+        if (c == term) break;
+        s += (char)c;
+        t0 = millis();
+    }
+    return String(s);
+}
+
+/* -------------------------------------------
+   UART MODEL
+   ------------------------------------------- */
+static const size_t UART_BUF = 63;          // 64-byte ring, one slot kept free
+
+void HostUart::pump()
+{
+    while (!pending_.empty() && pending_.front().at <= host::nowUs) {
+        if (rx_.size() < UART_BUF) rx_.push_back(pending_.front().b);
+        else                       overruns++;
+        pending_.pop_front();
+    }
+    if (rx_.size() > rxHigh) rxHigh = (uint32_t)rx_.size();
+}
+
+void HostUart::rxPush(uint64_t atUs, uint8_t b)
+{
+    auto it = pending_.end();
+    while (it != pending_.begin() && (it - 1)->at > atUs) --it;
+    pending_.insert(it, Rx{ atUs, b });
+}
+
+bool HostUart::rxWired(uint64_t atUs, uint8_t b)
+{
+    for (auto &p : pending_) {
+        if (p.at + byteUs_ <= atUs) continue;
+        if (p.at >= atUs + byteUs_) break;
+        p.b &= b;
+        return true;
+    }
+    rxPush(atUs, b);
+    return false;
+}
+
+void HostUart::rxPush(uint64_t atUs, const char* s)
+{
+    for (; *s; s++, atUs += byteUs_) rxPush(atUs, (uint8_t)*s);
+}
+
+int HostUart::available()
+{
+    if (rxFeed) rxFeed(*this);
+    pump();
+    return (int)rx_.size();
+}
+
+int HostUart::peek()
+{
+    if (rxFeed) rxFeed(*this);
+    pump();
+    return rx_.empty() ? -1 : rx_.front();
+}
+
+int HostUart::read()
+{
+    if (rxFeed) rxFeed(*this);
+    pump();
+    if (rx_.empty()) return -1;
+    uint8_t b = rx_.front();
+    rx_.pop_front();
+    return b;
+}
+
+size_t HostUart::write(uint8_t b)
+{
+    if (txFree) {
+        if (txHook) txHook(host::nowUs, b);
+        return 1;
+    }
+    if (bitBang_) {
+        host::advance(byteUs_);                 // CPU busy for the whole byte
+        if (txHook) txHook(host::nowUs, b);
+        return 1;
+    }
+    uint64_t limit = (uint64_t)UART_BUF * byteUs_;
+    if (txDoneUs_ > host::nowUs + limit)        // buffer full: block until a slot frees
+        host::advance(txDoneUs_ - limit - host::nowUs);
+    txDoneUs_ = (txDoneUs_ > host::nowUs ? txDoneUs_ : host::nowUs) + byteUs_;
+    if (txHook) txHook(txDoneUs_, b);
+    return 1;
+}
+
+void HostUart::flush()
+{
+    if (txDoneUs_ > host::nowUs) host::advance(txDoneUs_ - host::nowUs);
+}
+
+/* -------------------------------------------
+   CORE OBJECTS
+   ------------------------------------------- */
+HardwareSerial Serial;
+EEPROMClass    EEPROM;
+TwoWire        Wire;
+SPIClass       SPI;
+
+void (*Servo::onWrite)(Servo &, int) = 0;
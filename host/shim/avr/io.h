@@ -0,0 +1,14 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/avr/io.h - registers the firmware touches
+ */
+
+#ifndef HOST_IO_H
+#define HOST_IO_H
+
+#include <stdint.h>
+
+extern uint8_t MCUSR;
+#define WDRF                3
+
+#endif
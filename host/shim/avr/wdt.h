@@ -0,0 +1,29 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/shim/avr/wdt.h - watchdog on the virtual clock
+ * A timeout throws host::Reset out of the firmware.
+ */
+
+#ifndef HOST_WDT_H
+#define HOST_WDT_H
+
+#include <Arduino.h>
+
+#define WDTO_15MS           0
+#define WDTO_30MS           1
+#define WDTO_60MS           2
+#define WDTO_120MS          3
+#define WDTO_250MS          4
+#define WDTO_500MS          5
+#define WDTO_1S             6
+#define WDTO_2S             7
+#define WDTO_4S             8
+#define WDTO_8S             9
+
+#define wdt_reset()         host::wdtKick()
+// WDTO_15MS is only used to reboot on purpose, followed by a
+// spin loop that never reads the clock: fire it straight away.
+#define wdt_enable(t)       ((t) == WDTO_15MS ? host::wdtFire() : host::wdtSet(true, 16UL << (t)))
+#define wdt_disable()       host::wdtSet(false, 0)
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/telem_sim.cpp - GPRS telemetry end to end: bytes/day, latency, drops
+ *
+ * Runs the whole firmware (default smart_bin.h
+ * config, so TELEM_ENABLED) for three days
+ * against the world models, with the GPRS link
+ * down from 24 h for a few hours. The SIM800
+ * model POSTs each HTTPDATA body to a sink on
+ * 127.0.0.1, which decodes it as the dispatch
+ * backend would: 32-byte frames, version,
+ * DEVICE_ID, sequence number.
+ *
+ *   telem_sim [hours]      link down from 24 h for this long (default 6)
+ *
+ * Exit status 1 if a frame is malformed, a
+ * sequence number arrives twice, the frames
+ * missing at the sink differ from the device's
+ * own dropped-frames count, or the board
+ * resets.
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const uint64_t S     = 1000000ULL;
+static const uint64_t H     = 3600 * S;
+static const uint64_t RUN_H = 72;
+static const uint64_t OUT_H = 24;           // link down from here
+
+/* -------------------------------------------
+   SINK: the dispatch backend
+   ------------------------------------------- */
+struct Frame {
+    uint16_t seq;
+    uint32_t sampleS;           // device uptime when sampled
+    uint64_t deliveredUs;       // virtual time of the POST
+};
+
+static std::mutex         sinkLock;
+static std::vector<Frame> frames;
+static uint32_t           sinkPosts     = 0;
+static uint32_t           sinkRejected  = 0;    // POSTs answered 400
+static uint32_t           sinkBadFrames = 0;
+static uint32_t           sinkDropped   = 0;    // device's count, summed per POST
+
+static uint32_t le(const uint8_t* p, uint8_t n)
+{
+    uint32_t v = 0;
+    while (n--) v = v << 8 | p[n];
+    return v;
+}
+
+/* One connection = one POST. 400 if any frame is malformed. */
+static void sinkServe(int fd)
+{
+    std::string req;
+    char buf[512];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) req.append(buf, n);
+
+    size_t hdrEnd = req.find("\r\n\r\n");
+    size_t lenAt  = req.find("Content-Length: ");
+    size_t simAt  = req.find("X-Sim-Us: ");
+    bool   ok     = hdrEnd != std::string::npos && lenAt < hdrEnd && simAt < hdrEnd;
+    std::string body;
+    uint64_t    atUs = 0;
+    if (ok) {
+        body = req.substr(hdrEnd + 4);
+        atUs = strtoull(req.c_str() + simAt + 10, 0, 10);
+        ok   = body.size() == strtoul(req.c_str() + lenAt + 16, 0, 10) &&
+               body.size() && body.size() % TELEM_FRAME_LEN == 0;
+    }
+
+    std::vector<Frame> got;
+    uint8_t dropped = 0;
+    for (size_t i = 0; ok && i < body.size(); i += TELEM_FRAME_LEN) {
+        const uint8_t* f = (const uint8_t*)body.data() + i;
+        if (f[0] != TELEM_VERSION || le(f + 30, 2) != DEVICE_ID) { ok = false; break; }
+        got.push_back(Frame{ (uint16_t)le(f + 2, 2), le(f + 4, 4), atUs });
+        if (f[29] > dropped) dropped = f[29];   // since the last good POST
+    }
+
+    {
+        std::lock_guard<std::mutex> g(sinkLock);
+        sinkPosts++;
+        if (ok) {
+            frames.insert(frames.end(), got.begin(), got.end());
+            sinkDropped += dropped;
+        } else {
+            sinkRejected++;
+            sinkBadFrames += body.size() / TELEM_FRAME_LEN;
+        }
+    }
+    const char* rsp = ok ? "HTTP/1.0 200 OK\r\n\r\n" : "HTTP/1.0 400 Bad Request\r\n\r\n";
+    if (write(fd, rsp, strlen(rsp)) < 0) perror("sink write");
+    close(fd);
+}
+
+static void sinkRun(int lfd)
+{
+    for (;;) {
+        int fd = accept(lfd, 0, 0);
+        if (fd >= 0) sinkServe(fd);
+    }
+}
+
+/* Listens on an ephemeral port, 0 on failure */
+static int sinkStart()
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in a = {};
+    socklen_t   l = sizeof(a);
+    a.sin_family      = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || bind(fd, (sockaddr*)&a, sizeof(a)) < 0 || listen(fd, 4) < 0 ||
+        getsockname(fd, (sockaddr*)&a, &l) < 0) {
+        perror("sink");
+        return 0;
+    }
+    std::thread(sinkRun, fd).detach();
+    return ntohs(a.sin_port);
+}
+
+/* -------------------------------------------
+   MAIN
+   ------------------------------------------- */
+int main(int argc, char** argv)
+{
+    double   downH   = argc > 1 ? atof(argv[1]) : 6;
+    uint64_t downUs  = OUT_H * H;
+    uint64_t upUs    = downUs + (uint64_t)(downH * H);
+
+    world::httpPort = sinkStart();
+    if (!world::httpPort) return 1;
+
+    host::millisTickUs = 100;               // 3 days: coarser clock, same results
+    world::modemAttach();
+    world::echoAttach();
+    world::echoCm[PIN_ECHO_BIO] = 60;
+    world::echoCm[PIN_ECHO_NON] = 30;
+
+    uint64_t loopMaxUs[2] = { 0, 0 };       // link up / down
+    uint64_t txDown       = 0;
+    bool     reset        = false;
+    try {
+        world::gpsFeed(2 * S);
+        setup();
+        uint64_t last = host::nowUs;
+        while (host::nowUs < RUN_H * H) {
+            bool down = host::nowUs >= downUs && host::nowUs < upUs;
+            world::gprsUp = !down;
+            world::gpsFeed(host::nowUs + 2 * S);
+            uint64_t tx0 = world::modemStats->txBytes;
+
+            loop();
+
+            if (down) txDown += world::modemStats->txBytes - tx0;
+            uint64_t gap = host::nowUs - last;
+            if (gap > loopMaxUs[down]) loopMaxUs[down] = gap;
+            last = host::nowUs;
+        }
+    } catch (host::Reset &) {
+        reset = true;
+    }
+
+    std::lock_guard<std::mutex> g(sinkLock);
+    std::sort(frames.begin(), frames.end(), [](const Frame &a, const Frame &b) { return a.seq < b.seq; });
+    uint32_t dup = 0, missing = 0;
+    for (size_t i = 1; i < frames.size(); i++) {
+        if (frames[i].seq == frames[i - 1].seq) dup++;
+        else missing += frames[i].seq - frames[i - 1].seq - 1;
+    }
+    if (!frames.empty()) missing += frames[0].seq;
+
+    // Latency: sampled while the link was up vs. waited out the outage
+    double   latSum[2] = { 0, 0 }, latMax[2] = { 0, 0 };
+    uint32_t latN[2]   = { 0, 0 };
+    for (const Frame &f : frames) {
+        uint64_t sampleUs = (uint64_t)f.sampleS * S;
+        int      k        = sampleUs >= downUs && sampleUs < upUs;
+        double   m        = (f.deliveredUs - sampleUs) / 60e6;
+        latSum[k] += m;
+        latN[k]++;
+        if (m > latMax[k]) latMax[k] = m;
+    }
+
+    double days  = RUN_H / 24.0;
+    double upDay = (RUN_H * H - (upUs - downUs)) / (24.0 * H);
+    printf("run:       %llu h, GPRS down %.1f h from %llu h, sample every %lu min, POST every %lu min, queue %u frames\n",
+           (unsigned long long)RUN_H, downH, (unsigned long long)OUT_H,
+           TELEM_SAMPLE_MS / 60000UL, TELEM_POST_MS / 60000UL, TELEM_QUEUE_LEN);
+    printf("POSTs:     %u at the sink (%u rejected), %u failed on the device\n",
+           sinkPosts, sinkRejected, dev->telemFailCount);
+    printf("frames:    %zu delivered, %u missing (device counted %u dropped), %u duplicate, %u malformed\n",
+           frames.size() - dup, missing, sinkDropped, dup, sinkBadFrames);
+    printf("bytes/day: %.0f payload, %.0f SIM800 UART TX (AT, SMS and HTTPDATA)\n",
+           frames.size() * TELEM_FRAME_LEN / days,
+           (world::modemStats->txBytes - txDown) / upDay);
+    for (int k = 0; k < 2; k++)
+        if (latN[k])
+            printf("latency:   %-22s %3u frames, avg %5.1f min, max %5.1f min\n",
+                   k ? "sampled during outage" : "sampled with link up", latN[k], latSum[k] / latN[k], latMax[k]);
+    printf("loop max:  %.0f ms with link up, %.0f ms while down\n", loopMaxUs[0] / 1e3, loopMaxUs[1] / 1e3);
+
+    bool ok = !reset && !dup && !sinkBadFrames && missing == sinkDropped;
+    if (reset) printf("FAIL: the board reset\n");
+    else if (!ok) printf("FAIL: frames lost, repeated or malformed without the device counting them\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/uart_bench.cpp - hardware UART load: console and trace
+ *
+ * Runs the whole firmware with the GPS sending
+ * the default NEO-6M sentence set and measures,
+ * per phase, what leaves on TX (load against
+ * 9600 baud) and whether the GPS is starved
+ * (NMEA checksum failures, RX overruns):
+ *
+ *   idle     nothing sent to the console
+ *   ping     closed-loop PING: the next one goes
+ *            2 ms after each reply (or a 500 ms
+ *            timeout), so cmds/s is the
+ *            console's command throughput
+ *   paced    one PING every 1037 ms (drifts
+ *            across the GPS second instead of
+ *            locking to it): what a PC tool
+ *            polling once a second costs
+ *   stray    as paced, plus a stray 0x00 on the
+ *            RX line every 2.3 s (a glitch, or
+ *            the GPS at power-up): the console
+ *            must stay in phase with the PC
+ *   stream   STREAM on (resent until acked),
+ *            EVT_SAMPLE rate
+ *
+ *   console_bench [-g min]     -g min: GPS sends RMC + GGA only
+ *
+ * The PC and the GPS share the RX line: a
+ * console byte that overlaps a GPS byte ANDs
+ * into it (HostUart::rxWired()), damaging
+ * both. Built twice: console_bench (default
+ * smart_bin.h) and trace_bench (TRACE_RECORD).
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <vector>
+
+static const uint64_t S  = 1000000ULL;
+static const uint64_t MS = 1000ULL;
+
+enum Phase { P_WARMUP, P_IDLE, P_PING, P_PACED, P_STRAY, P_STREAM, P_END };
+static const char* const PHASE_NAME[] = { "warmup", "idle", "ping", "paced", "stray", "stream" };
+static const uint32_t    PHASE_END_S[] = { 20, 50, 80, 140, 200, 230 };
+
+struct Stats {
+    uint64_t txBytes, frameBytes, traceBytes;
+    uint32_t traceRec[0x80];
+    uint32_t gpsOK, gpsBad, overruns, rxHigh;
+    uint32_t sent, ok, crcErr, lost, collided, samples;
+    uint64_t latSumUs, latMaxUs;
+};
+
+static Phase    phase = P_WARMUP;
+static Stats    st[P_END];
+
+/* -------------------------------------------
+   PC SIDE: FRAMES OUT
+   ------------------------------------------- */
+static uint16_t crc16(uint16_t crc, uint8_t b)
+{
+    crc ^= (uint16_t)b << 8;
+    for (uint8_t i = 0; i < 8; i++)
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    return crc;
+}
+
+static bool     waiting  = false;
+static uint8_t  expect   = 0;       // reply type of the command in flight
+static uint64_t sentUs   = 0;
+
+static void pcSend(uint64_t atUs, uint8_t type, const uint8_t* p, uint8_t len)
+{
+    uint8_t raw[48];
+    raw[0] = type;
+    memcpy(raw + 1, p, len);
+    uint8_t  n   = len + 1;
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < n; i++) crc = crc16(crc, raw[i]);
+    raw[n++] = (uint8_t)crc;
+    raw[n++] = (uint8_t)(crc >> 8);
+
+    std::vector<uint8_t> out(1, 0);
+    for (uint8_t i = 0; i <= n; ) {
+        uint8_t j = i;
+        while (j < n && raw[j]) j++;
+        out.push_back((uint8_t)(j - i + 1));
+        out.insert(out.end(), raw + i, raw + j);
+        i = j + 1;
+    }
+    out.push_back(0);
+
+    bool hit = false;
+    for (size_t i = 0; i < out.size(); i++)
+        hit |= Serial.rxWired(atUs + i * Serial.byteUs(), out[i]);
+    if (hit) st[phase].collided++;
+    st[phase].sent++;
+    waiting = true;
+    expect  = type | RSP_FLAG;
+    sentUs  = atUs;
+}
+
+static void ping(uint64_t atUs)   { pcSend(atUs, CMD_PING, 0, 0); }
+static void stream(uint64_t atUs) { uint8_t on = 1; pcSend(atUs, CMD_STREAM, &on, 1); }
+
+/* -------------------------------------------
+   PC SIDE: FRAMES IN (debug text skipped)
+   ------------------------------------------- */
+static uint8_t rxBuf[64];
+static uint8_t rxLen   = 0;
+static bool    inFrame = false;
+
+static void frame(uint64_t atUs, uint8_t* b, uint8_t n)
+{
+    uint8_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t code = b[i++];
+        if (i + code - 1 > n) return;
+        for (uint8_t k = 1; k < code; k++) b[o++] = b[i++];
+        if (code < 0xFF && i < n) b[o++] = 0;
+    }
+    if (o < 3) return;
+    uint16_t crc = 0xFFFF;
+    for (uint8_t k = 0; k + 2 < o; k++) crc = crc16(crc, b[k]);
+    if (crc != (b[o - 2] | (uint16_t)b[o - 1] << 8)) return;
+
+    Stats  &s    = st[phase];
+    uint8_t type = b[0];
+    s.frameBytes += n + 2;
+    if (type < 0x80) { s.traceBytes += n + 2; s.traceRec[type]++; return; }
+    if (type == EVT_SAMPLE) { s.samples++; return; }
+    if (!waiting || atUs < sentUs) return;     // paced: next one not sent yet
+
+    if (type == expect) {
+        s.ok++;
+        uint64_t lat = atUs - sentUs;
+        s.latSumUs += lat;
+        if (lat > s.latMaxUs) s.latMaxUs = lat;
+    } else if (type == RSP_ERROR) {
+        s.crcErr++;
+    } else {
+        return;                     // late reply to the previous phase
+    }
+    waiting = false;
+    if (phase == P_PING)                        ping(atUs + 2 * MS);
+    if (phase == P_PACED || phase == P_STRAY)   ping(sentUs + 1037 * MS);
+    if (phase == P_STREAM && type == RSP_ERROR) stream(atUs + 2 * MS);
+}
+
+static void pcRx(uint64_t atUs, uint8_t b)
+{
+    st[phase].txBytes++;
+    if (b == 0) {
+        if (inFrame && rxLen) { frame(atUs, rxBuf, rxLen); inFrame = false; }
+        else                  inFrame = true;
+        rxLen = 0;
+        return;
+    }
+    if (inFrame && rxLen < sizeof(rxBuf)) rxBuf[rxLen++] = b;
+}
+
+/* -------------------------------------------
+   MAIN
+   ------------------------------------------- */
+int main(int argc, char** argv)
+{
+    world::gpsMin = argc > 2 && !strcmp(argv[1], "-g") && !strcmp(argv[2], "min");
+    host::millisTickUs = 10;
+    world::modemAttach();
+    world::echoAttach();
+    world::echoCm[PIN_ECHO_BIO] = 60;
+    world::echoCm[PIN_ECHO_NON] = 30;
+    Serial.txHook = pcRx;
+    world::gpsFeed(2 * S);
+
+    setup();
+
+    uint32_t gpsOK0 = 0, gpsBad0 = 0, over0 = 0;
+    uint64_t strayUs = 0;
+    while (phase < P_END) {
+        world::gpsFeed(host::nowUs + 2 * S);
+        loop();
+
+        uint64_t now = host::nowUs;
+        if (phase == P_STRAY && now >= strayUs) {
+            Serial.rxWired(now, 0x00);
+            strayUs = now + 2300 * MS;
+        }
+        if (waiting && now > sentUs + 500 * MS) {
+            st[phase].lost++;
+            waiting = false;
+            if (phase == P_PING || phase == P_PACED || phase == P_STRAY) ping(now);
+            if (phase == P_STREAM)                   stream(now);
+        }
+        if (Serial.rxHigh > st[phase].rxHigh) st[phase].rxHigh = Serial.rxHigh;
+        Serial.rxHigh = 0;
+
+        if (now >= PHASE_END_S[phase] * S) {
+            Stats &s = st[phase];
+            s.gpsOK    = gps.passedChecksum() - gpsOK0;
+            s.gpsBad   = gps.failedChecksum() - gpsBad0;
+            s.overruns = Serial.overruns - over0;
+            gpsOK0  = gps.passedChecksum();
+            gpsBad0 = gps.failedChecksum();
+            over0   = Serial.overruns;
+
+            phase = (Phase)(phase + 1);
+            if (phase == P_PING || phase == P_PACED) ping(now);
+            if (phase == P_STREAM)                   stream(now);
+        }
+    }
+
+    printf("GPS: %s\n", world::gpsMin ? "RMC + GGA" : "default NEO-6M set");
+    printf("%-7s %5s %8s %6s %7s %7s %9s %6s   %-28s %7s %12s %9s\n",
+           "phase", "secs", "TX B/s", "load", "GPS ok", "GPS bad", "overruns", "RXmax",
+           "console sent/ok/err/lost/hit", "cmds/s", "lat avg/max", "samples/s");
+    for (int p = P_IDLE; p < P_END; p++) {
+        Stats   &s    = st[p];
+        double   secs = (double)(PHASE_END_S[p] - PHASE_END_S[p - 1]);
+        char     con[40] = "-", lat[24] = "-", cps[16] = "-";
+        if (s.sent) {
+            snprintf(con, sizeof(con), "%u/%u/%u/%u/%u", s.sent, s.ok, s.crcErr, s.lost, s.collided);
+            snprintf(cps, sizeof(cps), "%.1f", s.ok / secs);
+        }
+        if (s.ok) snprintf(lat, sizeof(lat), "%.0f/%.0f ms", s.latSumUs / 1e3 / s.ok, s.latMaxUs / 1e3);
+        printf("%-7s %5.0f %8.0f %5.0f%% %7u %7u %9u %6u   %-28s %7s %12s %9.1f\n",
+               PHASE_NAME[p], secs, s.txBytes / secs, 100.0 * s.txBytes * Serial.byteUs() / (secs * 1e6),
+               s.gpsOK, s.gpsBad, s.overruns, s.rxHigh, con, cps, lat, s.samples / secs);
+    }
+
+    if (TRACE_RECORD) {
+        printf("\ntrace   %5s %8s %6s  records/s by type\n", "", "B/s", "load");
+        for (int p = P_IDLE; p < P_END; p++) {
+            Stats &s    = st[p];
+            double secs = (double)(PHASE_END_S[p] - PHASE_END_S[p - 1]);
+            printf("%-7s %5s %8.0f %5.0f%% ", PHASE_NAME[p], "", s.traceBytes / secs,
+                   100.0 * s.traceBytes * Serial.byteUs() / (secs * 1e6));
+            for (int t = 0; t < 0x80; t++)
+                if (s.traceRec[t]) printf(" %02X:%.1f", t, s.traceRec[t] / secs);
+            printf("\n");
+        }
+    }
+    return 0;
+}
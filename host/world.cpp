@@ -0,0 +1,248 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/world.cpp - SIM800, GPS and ultrasonic models
+ */
+
+#include "world.h"
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+namespace world {
+
+/* -------------------------------------------
+   SIM800 MODEL
+   ------------------------------------------- */
+static const uint64_t MS           = 1000ULL;
+static const uint64_t MODEM_BOOT_MS = 6000ULL;
+
+bool        modemUp    = true;
+bool        gprsUp     = true;
+int         httpPort   = 0;
+static ModemStats ownStats;
+ModemStats* modemStats = &ownStats;
+void      (*smsHook)(uint64_t, const char*)          = 0;
+int       (*postHook)(uint64_t, const char*, size_t) = 0;
+
+#if USE_MODEM
+enum ModemMode { MM_CMD, MM_SMS, MM_DATA };
+static ModemMode   mode      = MM_CMD;
+static std::string line;
+static std::string smsText;
+static std::string httpUrl;
+static std::string httpBody;
+static long        dataLeft  = 0;
+static uint64_t    dataFromUs = 0;      // DOWNLOAD sent: body bytes from here
+static uint64_t    bootingUs = 0;       // CFUN reset: silent until then
+
+static void reply(uint64_t atUs, const char* s)
+{
+    uint64_t tail = sim800.rxTail();
+    if (tail && atUs <= tail) atUs = tail + sim800.byteUs();
+    sim800.rxPush(atUs, s);
+}
+
+/* The POST the SIM800 would make: HTTP/1.0 to the sink, status back.
+   601 (network error) if nothing is listening. */
+static int httpPost(uint64_t at)
+{
+    if (postHook)  return postHook(at, httpBody.data(), httpBody.size());
+    if (!httpPort) return 200;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in a = {};
+    a.sin_family      = AF_INET;
+    a.sin_port        = htons(httpPort);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (sockaddr*)&a, sizeof(a)) < 0) {
+        if (fd >= 0) close(fd);
+        return 601;
+    }
+
+    size_t p    = httpUrl.find("://");
+    size_t path = httpUrl.find('/', p == std::string::npos ? 0 : p + 3);
+    char   head[256];
+    snprintf(head, sizeof(head),
+             "POST %s HTTP/1.0\r\nContent-Type: application/octet-stream\r\n"
+             "Content-Length: %zu\r\nX-Sim-Us: %llu\r\n\r\n",
+             path == std::string::npos ? "/" : httpUrl.c_str() + path,
+             httpBody.size(), (unsigned long long)at);
+    std::string req = head + httpBody;
+    for (size_t off = 0; off < req.size(); ) {
+        ssize_t n = write(fd, req.data() + off, req.size() - off);
+        if (n <= 0) break;
+        off += n;
+    }
+    shutdown(fd, SHUT_WR);
+
+    char rsp[64] = "";
+    ssize_t n = read(fd, rsp, sizeof(rsp) - 1);
+    close(fd);
+    int status = 0;
+    if (n <= 0 || sscanf(rsp, "HTTP/%*d.%*d %d", &status) != 1) return 601;
+    return status;
+}
+
+static void command(uint64_t at, const std::string &c)
+{
+    ModemStats &st = *modemStats;
+    st.lines++;
+
+    if (c.compare(0, 8, "AT+CMGS=") == 0) {
+        reply(at + 50 * MS, "\r\n> ");
+        smsText.clear();
+        mode = MM_SMS;
+        return;
+    }
+    if (c.compare(0, 12, "AT+HTTPDATA=") == 0) {
+        dataLeft = atol(c.c_str() + 12);
+        httpBody.clear();
+        dataFromUs = at + 20 * MS;
+        reply(dataFromUs, "\r\nDOWNLOAD\r\n");
+        mode = dataLeft > 0 ? MM_DATA : MM_CMD;
+        return;
+    }
+    if (c == "ATE0") {
+        st.inits++;
+        st.lastInitUs = at;
+    }
+    if (c == "AT+CFUN=1,1") {
+        st.resets++;
+        reply(at + 20 * MS, "\r\nOK\r\n");
+        bootingUs = at + MODEM_BOOT_MS * MS;
+        reply(bootingUs, "\r\nRDY\r\n\r\n+CFUN: 1\r\n\r\nCall Ready\r\n\r\nSMS Ready\r\n");
+        return;
+    }
+    if (c.compare(0, 19, "AT+HTTPPARA=\"URL\",\"") == 0)
+        httpUrl = c.substr(19, c.size() - 20);
+
+    if (c == "AT+CSQ")            reply(at + 20 * MS, "\r\n+CSQ: 17,0\r\n\r\nOK\r\n");
+    else if (c == "AT+CPIN?")     reply(at + 20 * MS, "\r\n+CPIN: READY\r\n\r\nOK\r\n");
+    else if (c == "AT+CREG?")     reply(at + 20 * MS, "\r\n+CREG: 0,1\r\n\r\nOK\r\n");
+    else if (c == "AT+SAPBR=2,1") reply(at + 20 * MS, gprsUp ? "\r\n+SAPBR: 1,1,\"10.0.0.2\"\r\n\r\nOK\r\n"
+                                                              : "\r\n+SAPBR: 1,3,\"0.0.0.0\"\r\n\r\nOK\r\n");
+    else if (c == "AT+SAPBR=1,1") reply(at + 1000 * MS, gprsUp ? "\r\nOK\r\n" : "\r\nERROR\r\n");
+    else if (c == "AT+HTTPACTION=1") {
+        int  status = gprsUp ? httpPost(at) : 601;
+        char r[40];
+        snprintf(r, sizeof(r), "\r\n+HTTPACTION: 1,%d,0\r\n", status);
+        reply(at + 20 * MS, "\r\nOK\r\n");
+        reply(at + 2000 * MS, r);
+        if (status == 200) st.posts++;
+    }
+    else if (c.compare(0, 2, "AT") == 0) reply(at + 20 * MS, "\r\nOK\r\n");
+}
+
+static void modemTx(uint64_t at, uint8_t b)
+{
+    modemStats->txBytes++;
+    if (!modemUp || at < bootingUs) { mode = MM_CMD; line.clear(); return; }
+
+    switch (mode) {
+    case MM_SMS:
+        if (b == 26) {
+            ModemStats &st = *modemStats;
+            st.sms++;
+            st.lastSmsUs = at;
+            snprintf(st.lastSms, sizeof(st.lastSms), "%s", smsText.c_str());
+            if (smsHook) smsHook(at, smsText.c_str());
+            reply(at + 3000 * MS, "\r\n+CMGS: 42\r\n\r\nOK\r\n");
+            mode = MM_CMD;
+        } else if (b != '\n' || !smsText.empty()) {
+            smsText += (char)b;
+        }
+        break;
+
+    case MM_DATA:
+        if (at < dataFromUs) break;         // the LF of the command's CRLF
+        httpBody += (char)b;
+        if (--dataLeft == 0) {
+            reply(at + 20 * MS, "\r\nOK\r\n");
+            mode = MM_CMD;
+        }
+        break;
+
+    default:
+        if (b == '\r') {
+            if (!line.empty()) command(at, line);
+            line.clear();
+        } else if (b != '\n') {
+            line += (char)b;
+        }
+        break;
+    }
+}
+
+void modemAttach()
+{
+    sim800.txHook = modemTx;
+}
+#else
+void modemAttach() {}               // no SIM800 in this build
+#endif
+
+/* -------------------------------------------
+   GPS: default NEO-6M sentence set
+   ------------------------------------------- */
+bool            gpsMin    = false;
+static uint64_t gpsNextUs = 0;
+
+static void sentence(std::string &out, const char* body)
+{
+    uint8_t sum = 0;
+    for (const char* p = body; *p; p++) sum ^= (uint8_t)*p;
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+    out += '$';
+    out += body;
+    out += tail;
+}
+
+void gpsFeed(uint64_t untilUs)
+{
+    while (gpsNextUs < untilUs) {
+        uint32_t s = (uint32_t)(gpsNextUs / 1000000ULL) % 86400UL;
+        char t[16], b[96];
+        snprintf(t, sizeof(t), "%02u%02u%02u.00", s / 3600, s / 60 % 60, s % 60);
+
+        std::string out;
+        snprintf(b, sizeof(b), "GPRMC,%s,A,1435.12345,N,12059.56789,E,0.021,,181026,,,A", t);
+        sentence(out, b);
+        if (!gpsMin) sentence(out, "GPVTG,,T,,M,0.021,N,0.039,K,A");
+        snprintf(b, sizeof(b), "GPGGA,%s,1435.12345,N,12059.56789,E,1,08,1.01,12.3,M,45.6,M,,", t);
+        sentence(out, b);
+        if (!gpsMin) {
+            sentence(out, "GPGSA,A,3,02,05,13,15,18,20,24,29,,,,,1.89,1.01,1.60");
+            sentence(out, "GPGSV,3,1,11,02,37,044,32,05,62,315,36,13,40,184,30,15,45,210,34");
+            sentence(out, "GPGSV,3,2,11,18,21,099,27,20,36,153,33,24,18,049,25,29,55,341,38");
+            sentence(out, "GPGSV,3,3,11,30,03,265,,31,08,312,,46,50,230,");
+            snprintf(b, sizeof(b), "GPGLL,1435.12345,N,12059.56789,E,%s,A,A", t);
+            sentence(out, b);
+        }
+
+        Serial.rxPush(gpsNextUs, out.c_str());
+        gpsNextUs += 1000000ULL;
+    }
+}
+
+/* -------------------------------------------
+   ULTRASONIC
+   ------------------------------------------- */
+long echoCm[20];
+
+static unsigned long echoPulse(uint8_t pin, unsigned long timeoutUs)
+{
+    long cm = pin < 20 ? echoCm[pin] : 0;
+    unsigned long us = cm > 0 ? (unsigned long)((cm * 2000L + 33) / 34) : 0;
+    if (us == 0 || us > timeoutUs) { host::advance(timeoutUs); return 0; }
+    host::advance(us);
+    return us;
+}
+
+void echoAttach()
+{
+    host::pulseIn = echoPulse;
+}
+
+}
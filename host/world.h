@@ -0,0 +1,74 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * host/world.h - peripherals on the far side of the shims
+ *
+ * A SIM800 that answers the AT commands the
+ * firmware sends, a GPS that sends one NMEA
+ * burst per second, and ultrasonic echoes for
+ * a given distance per bin. Shared by the host
+ * drivers that run the whole firmware.
+ */
+
+#ifndef HOST_WORLD_H
+#define HOST_WORLD_H
+
+#include "smart_bin.h"
+
+namespace world {
+
+/* -------------------------------------------
+   SIM800 MODEL
+   Replies after a short processing delay;
+   SMS and HTTP take network time. While not
+   up it stays silent. AT+CFUN=1,1 takes it
+   down for MODEM_BOOT_MS, then SMS Ready.
+   Without gprsUp the bearer will not attach.
+   With httpPort set, AT+HTTPACTION=1 sends
+   the HTTPDATA body as an HTTP/1.0 POST to
+   127.0.0.1:httpPort (header X-Sim-Us: the
+   virtual time) and relays the status code;
+   otherwise every POST gets 200. postHook,
+   when set, answers the POST instead, and
+   smsHook sees every SMS the model accepts.
+   ------------------------------------------- */
+struct ModemStats {
+    uint32_t lines;             // AT commands received
+    uint32_t inits;             // ATE0 = one initModem()
+    uint32_t resets;            // AT+CFUN=1,1
+    uint32_t sms;               // SMS accepted (+CMGS)
+    uint32_t posts;             // HTTP POSTs answered 200
+    uint64_t txBytes;           // firmware -> SIM800, AT and data
+    uint64_t lastInitUs;
+    uint64_t lastSmsUs;
+    char     lastSms[48];
+};
+
+extern bool        modemUp;
+extern bool        gprsUp;
+extern int         httpPort;
+extern ModemStats* modemStats;      // points at the driver's copy
+extern void      (*smsHook)(uint64_t atUs, const char* text);
+extern int       (*postHook)(uint64_t atUs, const char* body, size_t len);     // HTTP status
+
+void modemAttach();
+
+/* -------------------------------------------
+   GPS: once a second, valid checksums. The
+   default NEO-6M set (RMC VTG GGA GSA 3xGSV
+   GLL, ~480 B) or, gpsMin, RMC + GGA only
+   (~140 B). Keeps Serial RX queued up to
+   untilUs.
+   ------------------------------------------- */
+extern bool gpsMin;
+void gpsFeed(uint64_t untilUs);
+
+/* -------------------------------------------
+   ULTRASONIC: distance per echo pin in cm,
+   0 = no echo. Installs host::pulseIn.
+   ------------------------------------------- */
+extern long echoCm[20];
+void echoAttach();
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * app_gps_test.cpp - GPS fix test front-end
+ *
+ * Build with APP_MODE = APP_GPS_TEST.
+ * GPS on the hardware UART (D0/D1) as in the
+ * bin firmware. Every second prints position,
+ * satellites and altitude to Serial and, if
+ * USE_LCD, to both LCDs.
+ */
+
+#include "smart_bin.h"
+
+#if APP_MODE == APP_GPS_TEST
+
+#if USE_LCD
+static void showGPS(LiquidCrystal_I2C &lcd)
+{
+    lcd.clear();
+    lcd.setCursor(0, 0);
+    if (gps.location.isValid()) {
+        lcd.print(gps.location.lat(), 4);
+        lcd.print(' ');
+        lcd.print(gps.location.lng(), 3);
+    } else if (millis() > 10000UL && gps.charsProcessed() < 10) {
+        lcd.print(F("GPS ERROR!"));
+        lcd.setCursor(0, 1);
+        lcd.print(F("Check Wires/Baud"));
+        return;
+    } else {
+        lcd.print(F("LOC: Waiting..."));
+    }
+    lcd.setCursor(0, 1);
+    lcd.print(F("S:"));
+    lcd.print(gps.satellites.value());
+    lcd.print(F(" A:"));
+    if (gps.altitude.isValid()) lcd.print(gps.altitude.meters(), 0);
+    else                        lcd.print(F("--"));
+}
+#endif
+
+/* -------------------------------------------
+   SETUP / LOOP
+   ------------------------------------------- */
+void setup()
+{
+    Serial.begin(9600);
+    Serial.println(F("=== GPS TEST ==="));
+    initLCD();
+    binLCD(binBio, F("GPS Test        "), F("Initializing... "));
+    binLCD(binNon, F("GPS Test        "), F("Initializing... "));
+}
+
+void loop()
+{
+    static unsigned long lastShow = 0;
+
+    halSerialPoll();
+    if (millis() - lastShow < 1000UL) return;
+    lastShow = millis();
+
+    if (millis() > 10000UL && gps.charsProcessed() < 10) {
+        Serial.println(F("!!! No GPS data - check wiring and baud rate"));
+    } else {
+        Serial.print(F("GPS:"));    Serial.print(gpsStr());
+        Serial.print(F(" Sats:"));  Serial.print(gps.satellites.value());
+        Serial.print(F(" Chars:")); Serial.print(gps.charsProcessed());
+        Serial.print(F(" BadCk:")); Serial.println(gps.failedChecksum());
+    }
+
+#if USE_LCD
+    showGPS(lcd1);
+    showGPS(lcd2);
+#endif
+}
+
+#endif // APP_MODE == APP_GPS_TEST
@@ -0,0 +1,121 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * app_modem_test.cpp - SIM800 self-test front-end
+ *
+ * Build with APP_MODE = APP_MODEM_TEST.
+ * Serial Monitor (9600, newline) commands:
+ *   TEST        run the module self-test
+ *   CSQ         print signal strength
+ *   SMS <text>  send <text> to PHONE
+ * Anything the modem prints is echoed.
+ */
+
+#include "smart_bin.h"
+
+#if APP_MODE == APP_MODEM_TEST
+
+static bool moduleReady = false;
+
+/* -------------------------------------------
+   ONE AT COMMAND -> EXPECTED TOKEN
+   ------------------------------------------- */
+static bool checkAT(const __FlashStringHelper* name,
+                    const __FlashStringHelper* cmd, const char* expect)
+{
+    Serial.print(name);
+    Serial.print(F("... "));
+    simFlush();
+    sim800.println(cmd);
+    bool ok = simWaitFor(expect, 2000);
+    Serial.println(ok ? F("PASS") : F("FAIL"));
+    return ok;
+}
+
+/* -------------------------------------------
+   SELF-TEST
+   ------------------------------------------- */
+static bool testModule()
+{
+    bool ok = true;
+
+    ok &= checkAT(F("Test 1: Module response"), F("AT"), "OK");
+    ok &= checkAT(F("Test 2: SIM card"), F("AT+CPIN?"), "READY");
+
+    // +CREG: <n>,<stat>  stat 1 = home, 5 = roaming
+    Serial.print(F("Test 3: Network registration... "));
+    simFlush();
+    sim800.println(F("AT+CREG?"));
+    int stat = -1;
+    if (simWaitFor("+CREG: ", 2000)) {
+        simReadInt(500);
+        stat = simReadInt(500);
+    }
+    bool reg = (stat == 1 || stat == 5);
+    Serial.println(reg ? F("PASS") : F("FAIL (not registered)"));
+    ok &= reg;
+
+    Serial.print(F("Test 4: Signal strength... "));
+    int sig = getSignal();              // -1 = no reply, 99 = not known
+    bool sigOK = (sig > 0 && sig != 99);
+    Serial.print(sigOK ? F("PASS  CSQ=") : F("FAIL  CSQ="));
+    Serial.println(sig);
+    ok &= sigOK;
+
+    ok &= checkAT(F("Test 5: SMS text mode"), F("AT+CMGF=1"), "OK");
+    return ok;
+}
+
+static void runTest()
+{
+    Serial.println(F("--- Module test ---"));
+    moduleReady = testModule();
+    if (moduleReady) {
+        Serial.println(F("Module is ready"));
+    } else {
+        Serial.println(F("Module test FAILED - check:"));
+        Serial.println(F("- Power supply (SIM800 needs ~4V, 2A peaks)"));
+        Serial.println(F("- Wiring (D4 <- SIM TX, D5 -> SIM RX)"));
+        Serial.println(F("- SIM card inserted"));
+    }
+    Serial.println(F("Commands: TEST, CSQ, SMS <text>"));
+}
+
+/* -------------------------------------------
+   SETUP / LOOP
+   ------------------------------------------- */
+void setup()
+{
+    Serial.begin(9600);
+    Serial.println(F("=== SIM800 MODEM TEST ==="));
+    initModem(MODEM_POWERUP_MS);
+    runTest();
+}
+
+void loop()
+{
+    while (sim800.available()) Serial.write(sim800.read());
+
+    if (!Serial.available()) return;
+    String cmd = Serial.readStringUntil('\n');
+    cmd.trim();
+
+    if (cmd.equalsIgnoreCase(F("TEST"))) {
+        runTest();
+    } else if (cmd.equalsIgnoreCase(F("CSQ"))) {
+        Serial.print(F("CSQ: "));
+        Serial.println(getSignal());
+    } else if (cmd.startsWith(F("SMS ")) || cmd.startsWith(F("sms "))) {
+        if (!moduleReady) {
+            Serial.println(F("Module not ready - run TEST first"));
+            return;
+        }
+        Serial.print(F("Sending to "));
+        Serial.println(PHONE);
+        Serial.println(sendSMS(cmd.substring(4).c_str()) ? F("SMS sent")
+                                                         : F("SMS failed - no +CMGS"));
+    } else if (cmd.length()) {
+        Serial.println(F("Commands: TEST, CSQ, SMS <text>"));
+    }
+}
+
+#endif // APP_MODE == APP_MODEM_TEST
@@ -0,0 +1,59 @@
+/*
+ * SMART WASTE BIN SYSTEM v3.1
+ * app_servo_test.cpp - servo lock test front-end
+ *
+ * Build with APP_MODE = APP_SERVO_TEST.
+ * Serial Monitor (9600, newline) commands:
+ *   LOCKBIO / UNLOCKBIO    SERVO_LOCKED / force open
+ *   LOCKNON / UNLOCKNON
+ *   BIO <deg> / NON <deg>  raw angle, to find
+ *                          SERVO_LOCKED / UNLOCKED
+ */
+
+#include "smart_bin.h"
+
+#if APP_MODE == APP_SERVO_TEST
+
+static void help()
+{
+    Serial.println(F("Commands: LOCKBIO, UNLOCKBIO, LOCKNON, UNLOCKNON,"));
+    Serial.println(F("          BIO <deg>, NON <deg>"));
+}
+
+/* -------------------------------------------
+   SETUP / LOOP
+   ------------------------------------------- */
+void setup()
+{
+    Serial.begin(9600);
+    Serial.println(F("=== SERVO TEST ==="));
+    Serial.print(F("LOCKED=")); Serial.print(SERVO_LOCKED);
+    Serial.print(F(" UNLOCKED=")); Serial.println(SERVO_UNLOCKED);
+    initServos(false);
+    help();
+}
+
+void loop()
+{
+    if (!Serial.available()) return;
+    String cmd = Serial.readStringUntil('\n');
+    cmd.trim();
+    cmd.toUpperCase();
+
+    if      (cmd == F("LOCKBIO"))   { binServo(binBio, true);  Serial.println(F("BIO LOCKED")); }
+    else if (cmd == F("UNLOCKBIO")) { binServo(binBio, false); Serial.println(F("BIO UNLOCKED")); }
+    else if (cmd == F("LOCKNON"))   { binServo(binNon, true);  Serial.println(F("NON-BIO LOCKED")); }
+    else if (cmd == F("UNLOCKNON")) { binServo(binNon, false); Serial.println(F("NON-BIO UNLOCKED")); }
+    else if (cmd.startsWith(F("BIO ")) || cmd.startsWith(F("NON "))) {
+        int deg = constrain(cmd.substring(4).toInt(), 0, 180);
+        Servo &srv = cmd.startsWith(F("BIO ")) ? servoBio : servoNon;
+        srv.write(deg);
+        Serial.print(cmd.substring(0, 3));
+        Serial.print(F(" -> "));
+        Serial.print(deg);
+        Serial.println(F(" deg"));
+    }
+    else if (cmd.length()) help();
+}
+
+#endif // APP_MODE == APP_SERVO_TEST
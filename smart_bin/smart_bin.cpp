@@ -14,15 +14,27 @@
 /* -------------------------------------------
    HARDWARE OBJECT DEFINITIONS
    ------------------------------------------- */
+#if USE_GPS
 TinyGPSPlus        gps;
+#endif
+#if USE_LCD
 LiquidCrystal_I2C  lcd1(0x27, 16, 2);
 LiquidCrystal_I2C  lcd2(0x25, 16, 2);
+#endif
+#if USE_LIGHT
 BH1750             lightMeter;
+#endif
+#if USE_MODEM
 SoftwareSerial     sim800(PIN_SIM_RX, PIN_SIM_TX);
+#endif
+#if USE_SERVO
 Servo              servoBio;
 Servo              servoNon;
+#endif
+#if USE_RFID
 MFRC522            rfidBio(PIN_RFID_BIO_SS, PIN_RFID_RST);
 MFRC522            rfidNonBio(PIN_RFID_NON_SS, PIN_RFID_RST);
+#endif
 
 /* -------------------------------------------
    STATE VARIABLE DEFINITIONS
@@ -32,41 +44,517 @@ float         currentLux     = 0.0f;
 bool          ambientLEDOn   = false;
 unsigned long lastLuxRead    = 0;
 
-bool          bioLocked      = false;
-bool          nonLocked      = false;
+static const char TITLE_BIO[] PROGMEM = "  BIO  WASTE    ";
+static const char TITLE_NON[] PROGMEM = " NON-BIO WASTE  ";
+
+BinState      binBio         = { "BIO", (const __FlashStringHelper*)TITLE_BIO,
+                               SUB_US_BIO, PIN_TRIG_BIO, PIN_ECHO_BIO,
+                               BIO_DEPTH_CM, BIO_FULL_CM, BIO_EMPTY_CM - BIO_FULL_CM,
+                               BIO_DEPTH_CM, BIO_FULL_CM, BIO_EMPTY_CM,
+                               BIO_DEPTH_CM, false, 0, 0, 0, 0
+#if USE_SERVO
+                               , &servoBio
+#endif
+#if USE_LCD
+                               , &lcd1
+#endif
+#if USE_RFID
+                               , &rfidBio
+#endif
+                             };
+BinState      binNon         = { "NON-BIO", (const __FlashStringHelper*)TITLE_NON,
+                               SUB_US_NON, PIN_TRIG_NON, PIN_ECHO_NON,
+                               NON_DEPTH_CM, NON_FULL_CM, NON_EMPTY_CM - NON_FULL_CM,
+                               NON_DEPTH_CM, NON_FULL_CM, NON_EMPTY_CM,
+                               NON_DEPTH_CM, false, 0, 0, 0, 0
+#if USE_SERVO
+                               , &servoNon
+#endif
+#if USE_LCD
+                               , &lcd2
+#endif
+#if USE_RFID
+                               , &rfidNonBio
+#endif
+                             };
+Device        device         = { { &binBio, &binNon }, 0, 0, 0, 0, 0, 0, 0, 0, 0
+#if TELEM_ENABLED
+                               , { { 0 } }, 0, 0, 0, 0, 0
+#endif
+                             };
+Device*       dev            = &device;
+
+Health        health[SUB_COUNT];
+uint8_t       healthReboots  = 0;
+static bool   smsLogPending  = false;
+static bool   smsLogFlushing = false;
+
+/* Survives a watchdog / soft reset (not a power cycle) */
+struct Persist {
+    uint16_t magic;
+    uint8_t  flags;             // bit i = bins[i] locked
+    uint8_t  sms[BIN_COUNT];    // reminders sent today
+    uint8_t  reboots;           // health reboots since power-on
+    uint8_t  reason;            // Subsystem, or 0xFF = watchdog/reset
+    uint8_t  check;
+};
+#define PERSIST_MAGIC       0x5B1Eu
+static Persist persist __attribute__((section(".noinit")));
+
+#if USE_CONSOLE
+static uint8_t       conRx[CON_FRAME_MAX + 1];  // COBS adds one byte
+static uint8_t       conRxLen     = 0;
+static bool          conInFrame   = false;
+static uint8_t       conCmd[CON_FRAME_MAX];
+static uint8_t       conCmdLen    = 0;          // waiting for conService()
+static bool          conStreaming = false;
+static unsigned int  conFrames    = 0;
+static unsigned int  conBadFrames = 0;
+static unsigned long conCrcErrAt  = 0;
+static uint8_t       rxHighWater  = 0;
+static unsigned int  conLoopMax   = 0;
+#endif
+
+/* -------------------------------------------
+   HELPER: LITTLE-ENDIAN PACK
+   ------------------------------------------- */
+void putU16(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+void putU32(uint8_t* p, uint32_t v)
+{
+    putU16(p,     (uint16_t)v);
+    putU16(p + 2, (uint16_t)(v >> 16));
+}
+
+/* -------------------------------------------
+   CONSOLE: FRAMING (COBS + CRC-16)
+   ------------------------------------------- */
+static uint16_t crc16(uint16_t crc, uint8_t b)
+{
+    crc ^= (uint16_t)b << 8;
+    for (uint8_t i = 0; i < 8; i++)
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    return crc;
+}
+
+void conSend(uint8_t type, const uint8_t* p, uint8_t len)
+{
+    uint8_t raw[CON_FRAME_MAX];
+    if (len > CON_FRAME_MAX - 3) len = CON_FRAME_MAX - 3;
+    raw[0] = type;
+    memcpy(raw + 1, p, len);
+    uint8_t  n   = len + 1;
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < n; i++) crc = crc16(crc, raw[i]);
+    putU16(raw + n, crc);
+    n += 2;
+
+    // COBS: each run up to the next zero is sent as <run length + 1> <run>
+    Serial.write((uint8_t)0);
+    for (uint8_t i = 0; i <= n; ) {
+        uint8_t j = i;
+        while (j < n && raw[j]) j++;
+        Serial.write((uint8_t)(j - i + 1));
+        Serial.write(raw + i, j - i);
+        i = j + 1;
+    }
+    Serial.write((uint8_t)0);
+}
+
+#if USE_CONSOLE
+/* -------------------------------------------
+   CONSOLE: RECEIVE
+   Non-blocking, fed one byte at a time by
+   halSerialPoll(). A good frame is parked in
+   conCmd until conService() runs it from
+   loop(), never from inside a modem wait.
+   ------------------------------------------- */
+/* Decoded length is at most n - 1, so out needs CON_FRAME_MAX */
+static uint8_t cobsDecode(const uint8_t* b, uint8_t n, uint8_t* out)
+{
+    uint8_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t code = b[i++];
+        if (i + code - 1 > n) return 0;
+        for (uint8_t k = 1; k < code; k++) out[o++] = b[i++];
+        if (code < 0xFF && i < n) out[o++] = 0;
+    }
+    return o;
+}
+
+/* false = not a frame. The raw bytes go back to
+   the GPS: after a stray 0x00 they are NMEA. */
+static bool conFrameEnd()
+{
+    uint8_t  f[CON_FRAME_MAX];
+    uint8_t  n   = cobsDecode(conRx, conRxLen, f);
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i + 2 < n; i++) crc = crc16(crc, f[i]);
+    if (n < 3 || crc != (f[n - 2] | ((uint16_t)f[n - 1] << 8))) {
+        conBadFrames++;
+#if USE_GPS
+        for (uint8_t i = 0; i < conRxLen; i++) gps.encode(conRx[i]);
+#endif
+        // GPS noise can fail CRC on every sentence: don't answer each one
+        if (millis() - conCrcErrAt >= CON_ERR_GAP_MS) {
+            uint8_t e[2] = { 0, CON_ERR_CRC };
+            conCrcErrAt = millis();
+            conSend(RSP_ERROR, e, 2);
+        }
+        return false;
+    }
+    if (conCmdLen) {                            // previous command not run yet
+        uint8_t e[2] = { f[0], CON_ERR_BUSY };
+        conBadFrames++;
+        conSend(RSP_ERROR, e, 2);
+        return true;
+    }
+    memcpy(conCmd, f, n - 2);
+    conCmdLen = n - 2;
+    return true;
+}
+
+// true = byte belongs to the console, false = GPS byte
+static bool conFeed(uint8_t c)
+{
+    if (c == 0x00) {
+        // A bad frame's closing 0x00 may open the next one, so a
+        // stray 0x00 on the GPS line cannot flip the frame phase
+        conInFrame = !(conInFrame && conRxLen && conFrameEnd());
+        conRxLen = 0;
+        return true;
+    }
+    if (!conInFrame) return false;
+    if (conRxLen < sizeof(conRx)) { conRx[conRxLen++] = c; return true; }
+
+    // Longer than any frame: a stray 0x00 on the GPS line, give the bytes back
+    conInFrame = false;
+    conBadFrames++;
+#if USE_GPS
+    for (uint8_t i = 0; i < conRxLen; i++) gps.encode(conRx[i]);
+#endif
+    conRxLen = 0;
+    return false;
+}
+#endif
+
+/* -------------------------------------------
+   TRACE: WRITE ONE RECORD TO SERIAL
+   ------------------------------------------- */
+static unsigned long traceLastMs = 0;
+
+#define TRACE_RX_SERIAL     0
+#define TRACE_RX_SIM        1
+
+#if TRACE_RECORD
+/* UART RX bytes read but not yet written, one batch per port */
+struct TraceRx {
+    uint8_t       type;                 // TR_NMEA / TR_MODEM
+    uint8_t       len;
+    unsigned long ms;                   // when the last one was read
+    uint8_t       b[TRACE_BATCH];
+};
+static TraceRx traceRx[2] = { { TR_NMEA, 0, 0, {} }, { TR_MODEM, 0, 0, {} } };
+#endif
+
+static void traceRaw(uint8_t type, uint16_t dt, const uint8_t* p, uint8_t len)
+{
+    uint8_t r[CON_FRAME_MAX - 3];
+    if (len > sizeof(r) - 2) len = sizeof(r) - 2;
+    putU16(r, dt);
+    memcpy(r + 2, p, len);
+    conSend(type, r, len + 2);
+}
+
+static void traceAt(unsigned long now, uint8_t type, const uint8_t* p, uint8_t len)
+{
+    unsigned long dt = now - traceLastMs;
+    if (dt > 0xFFFFUL) {
+        uint8_t t[4];
+        putU32(t, now);
+        traceRaw(TR_TIME, 0, t, 4);
+        dt = 0;
+    }
+    traceLastMs = now;
+    traceRaw(type, (uint16_t)dt, p, len);
+}
+
+#if TRACE_RECORD
+static void traceRxOut(TraceRx &t)
+{
+    if (!t.len) return;
+    uint8_t n = t.len;
+    t.len = 0;
+    traceAt(t.ms, t.type, t.b, n);
+}
+#endif
+
+/* Pending RX bytes go out first, older batch first, so records
+   stay in time order */
+void traceFlush()
+{
+#if TRACE_RECORD
+    uint8_t first = traceRx[TRACE_RX_SIM].len &&
+                    traceRx[TRACE_RX_SIM].ms < traceRx[TRACE_RX_SERIAL].ms;
+    traceRxOut(traceRx[first]);
+    traceRxOut(traceRx[!first]);
+#endif
+}
+
+/* at: when the input was sampled, for a reading that takes time */
+static void traceWriteAt(unsigned long at, uint8_t type, const uint8_t* p, uint8_t len)
+{
+    traceFlush();
+    traceAt(at, type, p, len);
+}
+
+void traceWrite(uint8_t type, const uint8_t* p, uint8_t len)
+{
+    traceWriteAt(millis(), type, p, len);
+}
+
+/* -------------------------------------------
+   TRACE: UART RX BYTES
+   Collected into one record per port,
+   stamped with the last byte's time: a
+   replay hands the batch over by then, so no
+   byte is late for the code that read it.
+   Written when TRACE_BATCH bytes are in, at
+   a 0x00 (a console command is acted on in
+   the same pass on replay), before any other
+   record, at each simWaitFor() and once per
+   loop (traceLoop()), so a busy poll
+   loop costs ~1.25 bytes out per byte in
+   instead of a frame per poll.
+   ------------------------------------------- */
+static void traceRxByte(uint8_t port, uint8_t c)
+{
+#if TRACE_RECORD
+    TraceRx &t = traceRx[port];
+    t.b[t.len++] = c;
+    t.ms = millis();
+    if (t.len == TRACE_BATCH || (port == TRACE_RX_SERIAL && c == 0)) traceFlush();
+#endif
+}
+
+/* -------------------------------------------
+   HAL: TRACED INPUTS
+   Every external input the logic depends on
+   goes through one of these, so a recorded
+   trace is enough to reproduce a run.
+   ------------------------------------------- */
+unsigned long halEcho(uint8_t echo, unsigned long timeoutUs)
+{
+    unsigned long at = millis();
+    unsigned long us = pulseIn(echo, HIGH, timeoutUs);
+    if (TRACE_RECORD) {
+        uint8_t r[3] = { echo };
+        putU16(r + 1, us > 0xFFFFUL ? 0xFFFF : (uint16_t)us);
+        traceWriteAt(at, TR_ECHO, r, 3);
+    }
+    return us;
+}
+
+float halLux()
+{
+    unsigned long at = millis();
+#if USE_LIGHT
+    float lux = lightMeter.readLightLevel();
+#else
+    float lux = 0.0f;
+#endif
+    if (TRACE_RECORD) traceWriteAt(at, TR_LUX, (const uint8_t*)&lux, 4);
+    return lux;
+}
+
+/* UART RX: console frames out, the rest to the GPS */
+void halSerialPoll()
+{
+#if USE_CONSOLE
+    int avail = Serial.available();
+    if (avail > rxHighWater) rxHighWater = (uint8_t)avail;
+#endif
+    while (Serial.available()) {
+        uint8_t c = Serial.read();
+        if (TRACE_RECORD) traceRxByte(TRACE_RX_SERIAL, c);
+#if USE_CONSOLE
+        if (conFeed(c)) continue;
+#endif
+#if USE_GPS
+        gps.encode(c);
+#endif
+    }
+}
+
+#if USE_MODEM
+/* SIM800 RX: one byte, -1 if none */
+int halSimRead()
+{
+    if (!sim800.available()) return -1;
+    uint8_t c = sim800.read();
+    if (TRACE_RECORD) traceRxByte(TRACE_RX_SIM, c);
+    return c;
+}
+#endif
+
+/* delay() with the UART drained: its RX buffer only holds ~66ms
+   of GPS data, and readDist() alone blocks for ~135ms */
+void halDelay(unsigned long ms)
+{
+    unsigned long t0 = millis();
+    while (millis() - t0 < ms)
+        if (APP_MODE == APP_BIN) halSerialPoll();
+}
+
+#if USE_RFID
+void halCard(MFRC522 &r, uint8_t reader)
+{
+    if (!TRACE_RECORD) return;
+    uint8_t buf[11] = { reader };
+    uint8_t n = r.uid.size > 10 ? 10 : r.uid.size;
+    memcpy(buf + 1, r.uid.uidByte, n);
+    traceWrite(TR_CARD, buf, n + 1);
+}
+#endif
+
+/* Peripheral present? id: see PROBE_* */
+uint8_t halProbe(uint8_t id, uint8_t result)
+{
+    if (TRACE_RECORD) {
+        uint8_t r[2] = { id, result };
+        traceWrite(TR_PROBE, r, 2);
+    }
+    return result;
+}
+
+/* -------------------------------------------
+   TRACE: BOOT RECORD
+   What setup() starts from, for a replay to
+   start from the same place:
+     u8 TRACE_VERSION, u16 TRACE_CONFIG,
+     u16 DEVICE_ID, u8 warm, u8 lock flags,
+     u8 healthReboots, u8 SMS log count,
+     u8 SMS log head, then per bin
+     u8 smsCount, u16 depthCm, u16 fullCm
+   ------------------------------------------- */
+void traceBoot(bool warm)
+{
+#if TRACE_RECORD
+    uint8_t r[10 + 5 * BIN_COUNT];
+    r[0] = TRACE_VERSION;
+    putU16(r + 1, TRACE_CONFIG);
+    putU16(r + 3, DEVICE_ID);
+    r[5] = warm;
+    r[6] = 0;
+    r[7] = healthReboots;
+    r[8] = EEPROM.read(EE_SMS_LOG);
+    r[9] = EEPROM.read(EE_SMS_LOG_HEAD);
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        BinState &b = *dev->bins[i];
+        if (b.locked) r[6] |= 1 << i;
+        r[10 + 5 * i] = b.smsCount;
+        putU16(r + 11 + 5 * i, b.depthCm);
+        putU16(r + 13 + 5 * i, b.fullCm);
+    }
+    traceWrite(TR_BOOT, r, sizeof(r));
+#endif
+}
+
+/* -------------------------------------------
+   TRACE: PER-LOOP OUTPUTS
+   State record only when something changed;
+   loop body time as a min/avg/max summary
+   every TRACE_LOOP_MS.
+   ------------------------------------------- */
+void traceLoop(unsigned long loopStart)
+{
+    static uint8_t       lastFlags = 0xFF;
+    static uint16_t      lastSMS   = 0xFFFF;
+    static unsigned long sumStart  = 0;
+    static unsigned long sumMs     = 0;
+    static uint16_t      loops = 0, minMs = 0xFFFF, maxMs = 0;
+    traceFlush();
 
-long          bioDist        = BIO_DEPTH_CM;
-long          nonDist        = NON_DEPTH_CM;
-unsigned long lastUSRead     = 0;
+    uint8_t flags = 0;
+    for (uint8_t i = 0; i < BIN_COUNT; i++) if (dev->bins[i]->locked) flags |= 1 << i;
+    if (flags != lastFlags || dev->smsSentCount != lastSMS) {
+        lastFlags = flags;
+        lastSMS   = dev->smsSentCount;
+        uint8_t r[3] = { flags };
+        putU16(r + 1, dev->smsSentCount);
+        traceWrite(TR_STATE, r, 3);
+    }
 
-int           bioFullCnt     = 0;
-int           bioEmptyCnt    = 0;
-int           nonFullCnt     = 0;
-int           nonEmptyCnt    = 0;
+    uint16_t body = (uint16_t)(millis() - loopStart);
+    loops++;
+    sumMs += body;
+    if (body < minMs) minMs = body;
+    if (body > maxMs) maxMs = body;
+    if (millis() - sumStart < TRACE_LOOP_MS) return;
 
-unsigned long bioLastSMSTime = 0;
-unsigned long nonLastSMSTime = 0;
-int           bioSMSCount    = 0;
-int           nonSMSCount    = 0;
-unsigned long dayStart       = 0;
-unsigned long lastDailySMS   = 0;
+    uint8_t r[8];
+    putU16(r,     loops);
+    putU16(r + 2, minMs);
+    putU16(r + 4, (uint16_t)(sumMs / loops));
+    putU16(r + 6, maxMs);
+    traceWrite(TR_LOOP, r, 8);
+    sumStart = millis();
+    sumMs    = 0;
+    loops    = 0;
+    minMs    = 0xFFFF;
+    maxMs    = 0;
+}
 
 /* -------------------------------------------
    HELPER: SEND SMS
    ------------------------------------------- */
-void sendSMS(const char* msg)
+#if USE_MODEM
+static bool modemCmd(const __FlashStringHelper* cmd)
 {
-    sim800.println(F("AT+CMGF=1"));   delay(300);
-    sim800.print(F("AT+CMGS=\""));
-    sim800.print(PHONE);
-    sim800.println(F("\""));          delay(300);
-    sim800.print(msg);
-    sim800.write(26);
-    delay(5000);
+    simFlush();
+    sim800.println(cmd);
+    return simWaitFor("OK", MODEM_OK_MS);
+}
+#endif
+
+/* The offline log and the health gate belong to the bin: a test
+   app always tries the modem and never writes the bin's EEPROM */
+bool sendSMS(const char* msg)
+{
+    bool ok = false;
+    bool logged = false;
+#if USE_MODEM
+    if (APP_MODE != APP_BIN || subOK(SUB_MODEM)) {
+        // Each step waits for its answer: a silent modem fails
+        // after one MODEM_OK_MS, not the 10 s network wait
+        if (modemCmd(F("AT+CMGF=1"))) {
+            sim800.print(F("AT+CMGS=\""));
+            sim800.print(PHONE);
+            sim800.println(F("\""));
+            if (simWaitFor(">", MODEM_OK_MS)) {
+                sim800.print(msg);
+                sim800.write(26);
+                ok = simWaitFor("+CMGS:", 10000);
+            }
+        }
+        healthReport(SUB_MODEM, ok);
+    }
+    if (ok) {
+        dev->smsSentCount++;
+    } else if (APP_MODE == APP_BIN && !smsLogFlushing) {
+        smsLog(msg);
+        logged = true;
+    }
+#endif
     if (DEBUG_MODE) {
-        Serial.print(F("[SMS] "));
+        Serial.print(ok ? F("[SMS] ") : logged ? F("[SMS LOGGED] ") : F("[SMS FAILED] "));
         Serial.println(msg);
     }
+    return ok;
 }
 
 /* -------------------------------------------
@@ -74,24 +562,28 @@ void sendSMS(const char* msg)
    ------------------------------------------- */
 String gpsStr()
 {
+#if USE_GPS
     if (gps.location.isValid()) {
         return String(gps.location.lat(), 6) + F(",") +
                String(gps.location.lng(), 6);
     }
+#endif
     return F("NoFix");
 }
 
 /* -------------------------------------------
    HELPER: SIGNAL STRENGTH
+   CSQ 0-31, 99 = not known, -1 = no reply
    ------------------------------------------- */
 int getSignal()
 {
-    sim800.println(F("AT+CSQ")); delay(400);
-    String r = "";
-    while (sim800.available()) r += (char)sim800.read();
-    int i = r.indexOf(F("+CSQ:"));
-    if (i != -1) return r.substring(i + 6, r.indexOf(',', i)).toInt();
-    return 0;
+#if USE_MODEM
+    simFlush();
+    sim800.println(F("AT+CSQ"));
+    return simWaitFor("+CSQ:", 500) ? simReadInt(100) : -1;
+#else
+    return -1;
+#endif
 }
 
 /* -------------------------------------------
@@ -111,7 +603,7 @@ long readDist(uint8_t trig, uint8_t echo)
         digitalWrite(trig, LOW);
         
         // Longer timeout for far objects, but also handle very close
-        long duration = pulseIn(echo, HIGH, 40000UL);
+        long duration = halEcho(echo, 40000UL);
         
         if (duration > 0) {
             long dist = (duration * 34L) / 2000L;
@@ -132,7 +624,7 @@ long readDist(uint8_t trig, uint8_t echo)
             digitalWrite(trig, LOW);  delayMicroseconds(2);
             digitalWrite(trig, HIGH); delayMicroseconds(10);
             digitalWrite(trig, LOW);
-            duration = pulseIn(echo, HIGH, 10000UL);
+            duration = halEcho(echo, 10000UL);
             
             if (duration > 0 && duration < 200) {
                 // Very close object
@@ -142,7 +634,7 @@ long readDist(uint8_t trig, uint8_t echo)
                 v[i] = 999L;
             }
         }
-        delay(10);
+        halDelay(10);
     }
     
     // If we got at least 3 valid readings, use median
@@ -162,6 +654,8 @@ long readDist(uint8_t trig, uint8_t echo)
         }
     }
     
+    if (minValid == 999L) dev->usTimeoutCount++;
+
     if (DEBUG_MODE && minValid == 999L) {
         Serial.print(F("WARNING: Sensor timeout on pin "));
         Serial.println(trig);
@@ -171,23 +665,16 @@ long readDist(uint8_t trig, uint8_t echo)
 }
 
 /* -------------------------------------------
-   LEVEL % - separate formula per bin
+   LEVEL % - per-bin calibration
    BIO:    (95 - dist) / 85 * 100
    NONBIO: (50 - dist) / 40 * 100
-   Both clamped 0-100%
+   Clamped 0-100%
    ------------------------------------------- */
-int bioPct()
-{
-    long d      = constrain(bioDist, (long)BIO_FULL_CM, (long)BIO_DEPTH_CM);
-    long filled = BIO_DEPTH_CM - d;
-    return (int)((filled * 100L) / BIO_USABLE_CM);
-}
-
-int nonPct()
+int binPct(const BinState &b)
 {
-    long d      = constrain(nonDist, (long)NON_FULL_CM, (long)NON_DEPTH_CM);
-    long filled = NON_DEPTH_CM - d;
-    return (int)((filled * 100L) / NON_USABLE_CM);
+    long d      = constrain(b.dist, b.fullCm, b.depthCm);
+    long filled = b.depthCm - d;
+    return (int)((filled * 100L) / (b.depthCm - b.fullCm));
 }
 
 /* -------------------------------------------
@@ -208,146 +695,171 @@ String levelBar(int pct)
    Goes to LOCKED(90) first so motor always
    travels the full arc to OPEN(0).
    ------------------------------------------- */
+#if USE_SERVO
 void servoForceOpen(Servo &srv)
 {
     srv.write(SERVO_LOCKED);    // 90 deg
-    delay(700);
+    halDelay(700);
     srv.write(SERVO_UNLOCKED);  // 0 deg
-    delay(700);
+    halDelay(700);
 }
+#endif
 
 /* -------------------------------------------
-   ULTRASONIC: INTERVAL + HYSTERESIS + CONFIRM
-   Each bin uses its own thresholds
+   BIN: SERVO / LCD FOR A GIVEN BIN
+   No-ops when the module is compiled out
    ------------------------------------------- */
-void updateDistances()
+void binServo(BinState &b, bool lock)
 {
-    if (millis() - lastUSRead < US_INTERVAL_MS) return;
-    lastUSRead = millis();
-
-    bioDist = readDist(PIN_TRIG_BIO, PIN_ECHO_BIO);
-    nonDist = readDist(PIN_TRIG_NON, PIN_ECHO_NON);
-
-    // ---- BIO BIN ----
-    if (!bioLocked) {
-        if (bioDist <= BIO_FULL_CM) { bioFullCnt++;  bioEmptyCnt = 0; }
-        else                        { bioFullCnt = 0; }
-
-        if (bioFullCnt >= CONFIRM_NEEDED) {
-            bioFullCnt = 0;
-            servoBio.write(SERVO_LOCKED);
-            bioLocked = true;
-            for (uint8_t i = 0; i < 3; i++) { tone(PIN_BUZZER, 1500, 150); delay(250); }
-            String msg = F("ALERT: BIO bin FULL!\nLevel:100%\nGPS:");
-            msg += gpsStr();
-            sendSMS(msg.c_str());
-            bioLastSMSTime = millis();
-            bioSMSCount    = 1;
-            if (DEBUG_MODE) Serial.println(F(">>> BIO LOCKED"));
+#if USE_SERVO
+    if (lock) b.servo->write(SERVO_LOCKED);
+    else      servoForceOpen(*b.servo);
+#endif
+}
+
+void binLCD(BinState &b, const __FlashStringHelper* l0, const __FlashStringHelper* l1)
+{
+#if USE_LCD
+    if (!subOK(SUB_LCD)) return;
+    LiquidCrystal_I2C &lcd = *b.lcd;
+    lcd.setCursor(0, 0);
+    lcd.print(l0);
+    lcd.setCursor(0, 1);
+    lcd.print(l1);
+#endif
+}
+
+/* -------------------------------------------
+   BIN STATE MACHINE: HYSTERESIS + CONFIRM
+   No I/O - returns the transition, if any
+   ------------------------------------------- */
+BinEvent stepBin(BinState &b, long dist)
+{
+    b.dist = dist;
+
+    if (!b.locked) {
+        if (dist <= b.fullCm) { b.fullCnt++;  b.emptyCnt = 0; }
+        else                  { b.fullCnt = 0; }
+
+        if (b.fullCnt >= CONFIRM_NEEDED) {
+            b.fullCnt = 0;
+            b.locked  = true;
+            return BIN_EVT_FULL;
         }
     } else {
-        if (bioDist >= BIO_EMPTY_CM) { bioEmptyCnt++;  bioFullCnt = 0; }
-        else                         { bioEmptyCnt = 0; }
-
-        if (bioEmptyCnt >= CONFIRM_NEEDED) {
-            bioEmptyCnt = 0;
-            servoForceOpen(servoBio);
-            bioLocked   = false;
-            bioSMSCount = 0;
-            tone(PIN_BUZZER, 2500, 100); delay(120);
-            tone(PIN_BUZZER, 2000, 100);
-            if (DEBUG_MODE) Serial.println(F(">>> BIO UNLOCKED (emptied)"));
+        if (dist >= b.emptyCm) { b.emptyCnt++;  b.fullCnt = 0; }
+        else                   { b.emptyCnt = 0; }
+
+        if (b.emptyCnt >= CONFIRM_NEEDED) {
+            b.emptyCnt = 0;
+            b.locked   = false;
+            b.smsCount = 0;
+            return BIN_EVT_EMPTIED;
         }
     }
+    return BIN_EVT_NONE;
+}
 
-    // ---- NON-BIO BIN ----
-    if (!nonLocked) {
-        if (nonDist <= NON_FULL_CM) { nonFullCnt++;  nonEmptyCnt = 0; }
-        else                        { nonFullCnt = 0; }
-
-        if (nonFullCnt >= CONFIRM_NEEDED) {
-            nonFullCnt = 0;
-            servoNon.write(SERVO_LOCKED);
-            nonLocked = true;
-            for (uint8_t i = 0; i < 3; i++) { tone(PIN_BUZZER, 1500, 150); delay(250); }
-            String msg = F("ALERT: NON-BIO bin FULL!\nLevel:100%\nGPS:");
-            msg += gpsStr();
-            sendSMS(msg.c_str());
-            nonLastSMSTime = millis();
-            nonSMSCount    = 1;
-            if (DEBUG_MODE) Serial.println(F(">>> NON-BIO LOCKED"));
-        }
-    } else {
-        if (nonDist >= NON_EMPTY_CM) { nonEmptyCnt++;  nonFullCnt = 0; }
-        else                         { nonEmptyCnt = 0; }
-
-        if (nonEmptyCnt >= CONFIRM_NEEDED) {
-            nonEmptyCnt = 0;
-            servoForceOpen(servoNon);
-            nonLocked   = false;
-            nonSMSCount = 0;
-            tone(PIN_BUZZER, 2500, 100); delay(120);
-            tone(PIN_BUZZER, 2000, 100);
-            if (DEBUG_MODE) Serial.println(F(">>> NON-BIO UNLOCKED (emptied)"));
-        }
+/* -------------------------------------------
+   BIN: APPLY TRANSITION TO HARDWARE
+   ------------------------------------------- */
+void handleBin(BinState &b, long dist)
+{
+    // Degraded: no echo at all -> hold current lock state
+    healthReport(b.sub, dist < 999L);
+    if (dist >= 999L) return;
+
+    switch (stepBin(b, dist)) {
+    case BIN_EVT_FULL: {
+        binServo(b, true);
+        for (uint8_t i = 0; i < 3; i++) { tone(PIN_BUZZER, 1500, 150); halDelay(250); }
+        String msg = F("ALERT: ");
+        msg += b.label;
+        msg += F(" bin FULL!\nLevel:100%\nGPS:");
+        msg += gpsStr();
+        sendSMS(msg.c_str());
+        b.lastSMSTime = millis();
+        b.smsCount    = 1;
+        if (DEBUG_MODE) { Serial.print(F(">>> ")); Serial.print(b.label); Serial.println(F(" LOCKED")); }
+        break;
+    }
+    case BIN_EVT_EMPTIED:
+        binServo(b, false);
+        tone(PIN_BUZZER, 2500, 100); halDelay(120);
+        tone(PIN_BUZZER, 2000, 100);
+        if (DEBUG_MODE) { Serial.print(F(">>> ")); Serial.print(b.label); Serial.println(F(" UNLOCKED (emptied)")); }
+        break;
+    default:
+        break;
     }
 }
 
+/* -------------------------------------------
+   ULTRASONIC: READ BOTH, THEN ACT
+   ------------------------------------------- */
+void updateDistances()
+{
+    if (millis() - dev->lastUSRead < US_INTERVAL_MS) return;
+    dev->lastUSRead = millis();
+
+    long d[BIN_COUNT];
+    for (uint8_t i = 0; i < BIN_COUNT; i++) d[i] = readDist(dev->bins[i]->trig, dev->bins[i]->echo);
+    for (uint8_t i = 0; i < BIN_COUNT; i++) handleBin(*dev->bins[i], d[i]);
+}
+
 /* -------------------------------------------
    SMS REPEAT: 3x PER DAY WHILE STILL FULL
    ------------------------------------------- */
+void remindBin(BinState &b, unsigned long now)
+{
+    if (!b.locked || b.smsCount >= MAX_SMS_PER_DAY) return;
+    if (now - b.lastSMSTime < SMS_INTERVAL_MS) return;
+
+    b.smsCount++;
+    String msg = F("REMINDER ");
+    msg += b.smsCount; msg += F("/"); msg += MAX_SMS_PER_DAY;
+    msg += F(": "); msg += b.label;
+    msg += F(" bin still FULL!\nGPS:"); msg += gpsStr();
+    sendSMS(msg.c_str());
+    b.lastSMSTime = now;
+    if (DEBUG_MODE) {
+        Serial.print(F("[SMS] ")); Serial.print(b.label);
+        Serial.print(F(" reminder "));
+        Serial.print(b.smsCount); Serial.print('/');
+        Serial.println(MAX_SMS_PER_DAY);
+    }
+}
+
 void checkRepeatSMS()
 {
     unsigned long now = millis();
 
-    if (now - dayStart >= DAY_RESET_MS) {
-        dayStart    = now;
-        bioSMSCount = bioLocked ? bioSMSCount : 0;
-        nonSMSCount = nonLocked ? nonSMSCount : 0;
+    if (now - dev->dayStart >= DAY_RESET_MS) {
+        dev->dayStart = now;
+        for (uint8_t i = 0; i < BIN_COUNT; i++)
+            if (!dev->bins[i]->locked) dev->bins[i]->smsCount = 0;
         if (DEBUG_MODE) Serial.println(F("[SMS] Day counter reset"));
     }
 
-    if (bioLocked && bioSMSCount < MAX_SMS_PER_DAY) {
-        if (now - bioLastSMSTime >= SMS_INTERVAL_MS) {
-            bioSMSCount++;
-            String msg = F("REMINDER ");
-            msg += bioSMSCount; msg += F("/"); msg += MAX_SMS_PER_DAY;
-            msg += F(": BIO bin still FULL!\nGPS:"); msg += gpsStr();
-            sendSMS(msg.c_str());
-            bioLastSMSTime = now;
-            if (DEBUG_MODE) {
-                Serial.print(F("[SMS] Bio reminder "));
-                Serial.print(bioSMSCount); Serial.print('/');
-                Serial.println(MAX_SMS_PER_DAY);
-            }
-        }
-    }
+    for (uint8_t i = 0; i < BIN_COUNT; i++) remindBin(*dev->bins[i], now);
 
-    if (nonLocked && nonSMSCount < MAX_SMS_PER_DAY) {
-        if (now - nonLastSMSTime >= SMS_INTERVAL_MS) {
-            nonSMSCount++;
-            String msg = F("REMINDER ");
-            msg += nonSMSCount; msg += F("/"); msg += MAX_SMS_PER_DAY;
-            msg += F(": NON-BIO bin still FULL!\nGPS:"); msg += gpsStr();
-            sendSMS(msg.c_str());
-            nonLastSMSTime = now;
-            if (DEBUG_MODE) {
-                Serial.print(F("[SMS] NonBio reminder "));
-                Serial.print(nonSMSCount); Serial.print('/');
-                Serial.println(MAX_SMS_PER_DAY);
-            }
-        }
+    // Daily report is the fallback channel when GPRS uploads are failing
+    bool telemHealthy = TELEM_ENABLED && (now - dev->telemLastOK < DAY_RESET_MS);
+    if (now - dev->lastDailySMS >= DAY_RESET_MS && telemHealthy) {
+        dev->lastDailySMS = now;
+        if (DEBUG_MODE) Serial.println(F("[SMS] Daily report skipped (GPRS OK)"));
     }
 
-    if (now - lastDailySMS >= DAY_RESET_MS) {
-        String msg = F("DAILY REPORT\nBIO:");
-        msg += (bioLocked ? F("FULL") : F("OK"));
-        msg += F("\nNON-BIO:");
-        msg += (nonLocked ? F("FULL") : F("OK"));
+    if (now - dev->lastDailySMS >= DAY_RESET_MS) {
+        String msg = F("DAILY REPORT");
+        for (uint8_t i = 0; i < BIN_COUNT; i++) {
+            msg += '\n'; msg += dev->bins[i]->label; msg += ':';
+            msg += (dev->bins[i]->locked ? F("FULL") : F("OK"));
+        }
         msg += F("\nSig:"); msg += getSignal();
         msg += F("\nGPS:"); msg += gpsStr();
         sendSMS(msg.c_str());
-        lastDailySMS = now;
+        dev->lastDailySMS = now;
         if (DEBUG_MODE) Serial.println(F("[SMS] Daily report sent"));
     }
 }
@@ -355,6 +867,7 @@ void checkRepeatSMS()
 /* -------------------------------------------
    RFID: GET UID STRING
    ------------------------------------------- */
+#if USE_RFID
 String getUID(MFRC522 &r)
 {
     String s = "";
@@ -367,12 +880,14 @@ String getUID(MFRC522 &r)
     return s;
 }
 
+#endif
+
 /* -------------------------------------------
    RFID: PROCESS CARD
    Authorized -> servoForceOpen + SMS
    Unauthorized -> reject tone + LCD
    ------------------------------------------- */
-void processCard(String uid, LiquidCrystal_I2C &lcd, bool isBioReader)
+void processCard(String uid, BinState &b)
 {
     if (DEBUG_MODE) {
         Serial.print(F("Card: "));
@@ -380,43 +895,25 @@ void processCard(String uid, LiquidCrystal_I2C &lcd, bool isBioReader)
     }
 
     if (uid == String(AUTH_UID1) || uid == String(AUTH_UID2)) {
-        tone(PIN_BUZZER, 2000, 100); delay(120);
+        tone(PIN_BUZZER, 2000, 100); halDelay(120);
         tone(PIN_BUZZER, 2500, 100);
 
-        if (isBioReader) {
-            servoForceOpen(servoBio);
-            bioLocked   = false;
-            bioSMSCount = 0;
-            lcd.setCursor(0, 0);
-            lcd.print(F("  BIO  WASTE    "));
-            lcd.setCursor(0, 1);
-            lcd.print(F("    UNLOCKED    "));
-            String msg = F("AUTH: BIO bin unlocked via RFID.\nGPS:");
-            msg += gpsStr();
-            sendSMS(msg.c_str());
-            if (DEBUG_MODE) Serial.println(F("AUTH -> BIO UNLOCKED + SMS sent"));
-        } else {
-            servoForceOpen(servoNon);
-            nonLocked   = false;
-            nonSMSCount = 0;
-            lcd.setCursor(0, 0);
-            lcd.print(F(" NON-BIO WASTE  "));
-            lcd.setCursor(0, 1);
-            lcd.print(F("    UNLOCKED    "));
-            String msg = F("AUTH: NON-BIO bin unlocked via RFID.\nGPS:");
-            msg += gpsStr();
-            sendSMS(msg.c_str());
-            if (DEBUG_MODE) Serial.println(F("AUTH -> NON-BIO UNLOCKED + SMS sent"));
-        }
-        delay(2000);
+        binServo(b, false);
+        b.locked   = false;
+        b.smsCount = 0;
+        binLCD(b, b.title, F("    UNLOCKED    "));
+        String msg = F("AUTH: ");
+        msg += b.label;
+        msg += F(" bin unlocked via RFID.\nGPS:");
+        msg += gpsStr();
+        sendSMS(msg.c_str());
+        if (DEBUG_MODE) { Serial.print(F("AUTH -> ")); Serial.print(b.label); Serial.println(F(" UNLOCKED + SMS sent")); }
+        halDelay(2000);
 
     } else {
         tone(PIN_BUZZER, 400, 300);
-        lcd.setCursor(0, 0);
-        lcd.print(F("  UNAUTHORIZED  "));
-        lcd.setCursor(0, 1);
-        lcd.print(F("  ACCESS DENIED "));
-        delay(2000);
+        binLCD(b, F("  UNAUTHORIZED  "), F("  ACCESS DENIED "));
+        halDelay(2000);
         if (DEBUG_MODE) Serial.println(F("UNAUTHORIZED"));
     }
 }
@@ -426,16 +923,16 @@ void processCard(String uid, LiquidCrystal_I2C &lcd, bool isBioReader)
    ------------------------------------------- */
 void checkRFID()
 {
-    if (rfidBio.PICC_IsNewCardPresent() && rfidBio.PICC_ReadCardSerial()) {
-        processCard(getUID(rfidBio), lcd1, true);
-        rfidBio.PICC_HaltA();
-        rfidBio.PCD_StopCrypto1();
-    }
-    if (rfidNonBio.PICC_IsNewCardPresent() && rfidNonBio.PICC_ReadCardSerial()) {
-        processCard(getUID(rfidNonBio), lcd2, false);
-        rfidNonBio.PICC_HaltA();
-        rfidNonBio.PCD_StopCrypto1();
+#if USE_RFID
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        MFRC522 &r = *dev->bins[i]->rfid;
+        if (!r.PICC_IsNewCardPresent() || !r.PICC_ReadCardSerial()) continue;
+        halCard(r, i);
+        processCard(getUID(r), *dev->bins[i]);
+        r.PICC_HaltA();
+        r.PCD_StopCrypto1();
     }
+#endif
 }
 
 /* -------------------------------------------
@@ -446,10 +943,47 @@ void updateLight()
     if (!lightSensorOK) return;
     if (millis() - lastLuxRead < 1000UL) return;
     lastLuxRead  = millis();
-    currentLux   = lightMeter.readLightLevel();
+    float lux    = halLux();
+    healthReport(SUB_LIGHT, lux >= 0.0f);   // BH1750 lib returns < 0 on I2C error
+    if (lux < 0.0f) return;
+    currentLux   = lux;
     ambientLEDOn = (currentLux < LUX_THRESHOLD);
 }
 
+#if USE_LCD
+/* -------------------------------------------
+   LCD: ONE BIN STATUS SCREEN
+   Line 0: "BIO          75%"
+   Line 1: "[======  ]  45cm" or "[========] FULL"
+   ------------------------------------------- */
+static void drawBinLCD(LiquidCrystal_I2C &lcd, const BinState &b)
+{
+    int p = binPct(b);
+
+    lcd.clear();
+    lcd.setCursor(0, 0);
+    lcd.print(b.label);
+    for (uint8_t i = strlen(b.label); i < 12; i++) lcd.print(' ');
+    if      (p < 10)  lcd.print(F("  "));
+    else if (p < 100) lcd.print(F(" "));
+    lcd.print(p);
+    lcd.print('%');
+
+    lcd.setCursor(0, 1);
+    lcd.print(levelBar(p));             // 10 chars [========]
+    if (b.locked) {
+        lcd.print(F(" FULL "));
+    } else {
+        lcd.print(F(" "));
+        if      (b.dist < 10)  lcd.print(F("  "));
+        else if (b.dist < 100) lcd.print(F(" "));
+        lcd.print(b.dist);
+        lcd.print(F("cm"));
+    }
+}
+
+#endif
+
 /* -------------------------------------------
    LCD LAYOUT (16x2) - Alternating Display
    Cycle 1: Line 0: "BIO          75%"
@@ -459,6 +993,8 @@ void updateLight()
    ------------------------------------------- */
 void updateLCD()
 {
+#if USE_LCD
+    if (!subOK(SUB_LCD)) return;        // degraded: bins still lock/unlock
     static unsigned long lastCycle = 0;
     static bool showGPS = false;
     
@@ -468,154 +1004,894 @@ void updateLCD()
         showGPS = !showGPS;
     }
 
-    if (showGPS && gps.location.isValid()) {
+#if USE_GPS
+    bool gpsFix = gps.location.isValid();
+#else
+    bool gpsFix = false;
+#endif
+    if (showGPS && gpsFix) {
+#if USE_GPS
         // ---- SHOW GPS ON BOTH LCDs ----
         String lat = String(gps.location.lat(), 5);
         String lng = String(gps.location.lng(), 5);
         
-        // BIO LCD - GPS
-        lcd1.clear();
-        lcd1.setCursor(0, 0);
-        lcd1.print(F("GPS:"));
-        lcd1.print(lat.substring(0, 11));
-        
-        lcd1.setCursor(0, 1);
-        lcd1.print(F("    "));
-        lcd1.print(lng.substring(0, 11));
-        
-        // NON-BIO LCD - GPS
-        lcd2.clear();
-        lcd2.setCursor(0, 0);
-        lcd2.print(F("GPS:"));
-        lcd2.print(lat.substring(0, 11));
-        
-        lcd2.setCursor(0, 1);
-        lcd2.print(F("    "));
-        lcd2.print(lng.substring(0, 11));
-        
+        for (uint8_t i = 0; i < BIN_COUNT; i++) {
+            LiquidCrystal_I2C &lcd = *dev->bins[i]->lcd;
+            lcd.clear();
+            lcd.setCursor(0, 0);
+            lcd.print(F("GPS:"));
+            lcd.print(lat.substring(0, 11));
+
+            lcd.setCursor(0, 1);
+            lcd.print(F("    "));
+            lcd.print(lng.substring(0, 11));
+        }
+#endif
     } else {
         // ---- SHOW NORMAL BIN STATUS ----
-        int bp = bioPct();
-        int np = nonPct();
-
-        // ---- BIO LCD (lcd1) ----
-        lcd1.clear();
-        lcd1.setCursor(0, 0);
-        lcd1.print(F("BIO         "));  // Removed "WASTE"
-        if      (bp < 10)  lcd1.print(F("  "));
-        else if (bp < 100) lcd1.print(F(" "));
-        lcd1.print(bp);
-        lcd1.print('%');
-
-        lcd1.setCursor(0, 1);
-        lcd1.print(levelBar(bp));           // 10 chars [========]
-        if (bioLocked) {
-            lcd1.print(F(" FULL "));
+        for (uint8_t i = 0; i < BIN_COUNT; i++) drawBinLCD(*dev->bins[i]->lcd, *dev->bins[i]);
+    }
+#endif
+}
+
+#if USE_MODEM
+/* -------------------------------------------
+   SIM800: WAIT FOR RESPONSE TOKEN
+   Streams modem output, no String buffer.
+   Every byte goes through halSimRead().
+   ------------------------------------------- */
+bool simWaitFor(const char* token, unsigned long timeoutMs)
+{
+    traceFlush();                   // one MODEM record per wait
+    uint8_t m = 0;
+    unsigned long t0 = millis();
+    while (millis() - t0 < timeoutMs) {
+        wdtKick();
+        if (APP_MODE == APP_BIN) halSerialPoll();   // keep GPS fed during long waits
+        int c = halSimRead();
+        if (c < 0) continue;
+        if (c == token[m]) {
+            if (token[++m] == '\0') return true;
         } else {
-            lcd1.print(F(" "));
-            if      (bioDist < 10)  lcd1.print(F("  "));
-            else if (bioDist < 100) lcd1.print(F(" "));
-            lcd1.print(bioDist);
-            lcd1.print(F("cm"));
+            m = (c == token[0]) ? 1 : 0;
+        }
+    }
+    return false;
+}
+
+/* Skips to the first digit; the character ending the number is
+   consumed too. Same MODEM record as the wait before it. */
+int simReadInt(unsigned long timeoutMs)
+{
+    int v = 0;
+    bool any = false;
+    unsigned long t0 = millis();
+    while (millis() - t0 < timeoutMs) {
+        int c = halSimRead();
+        if (c < 0) continue;
+        if (c < '0' || c > '9') {
+            if (any) break;
+            continue;
+        }
+        v = v * 10 + (c - '0');
+        any = true;
+    }
+    return any ? v : -1;
+}
+
+/* Discarded unread, so not traced: a replay that never delivers
+   these bytes runs the same */
+void simFlush()
+{
+    while (sim800.available()) sim800.read();
+}
+#endif
+
+#if TELEM_ENABLED
+/* -------------------------------------------
+   TELEMETRY: FRAME LAYOUT (little-endian)
+    0 u8   version          15 i32 lat  x1e6
+    1 u8   flags            19 i32 lng  x1e6
+    2 u16  seq              23 u16 SMS sent
+    4 u32  uptime (s)       25 u16 US timeouts
+    8 u8   bio %            27 u16 upload fails
+    9 u8   non %            29 u8  dropped frames
+   10 u16  bio dist (cm)
+   12 u16  non dist (cm)
+   14 u8   CSQ (0-31, 99 = unknown)
+   30 u16  DEVICE_ID
+   flags: b0 BIO locked b1 NON-BIO locked
+          b2 GPS fix    b3 light sensor OK
+   ------------------------------------------- */
+void telemSample()
+{
+    // Full queue: overwrite oldest frame (store-and-forward, bounded)
+    if (dev->telemCount == TELEM_QUEUE_LEN) {
+        dev->telemHead = (dev->telemHead + 1) % TELEM_QUEUE_LEN;
+        dev->telemCount--;
+        if (dev->telemDropCount < 255) dev->telemDropCount++;
+    }
+    uint8_t* f = dev->telemQueue[(dev->telemHead + dev->telemCount) % TELEM_QUEUE_LEN];
+    dev->telemCount++;
+
+#if USE_GPS
+    bool fix = gps.location.isValid();
+#else
+    bool fix = false;
+#endif
+    f[0] = TELEM_VERSION;
+    f[1] = (dev->bins[0]->locked ? 0x01 : 0) |
+           (dev->bins[1]->locked ? 0x02 : 0) |
+           (fix                  ? 0x04 : 0) |
+           (lightSensorOK        ? 0x08 : 0);
+    putU16(f + 2,  dev->telemSeq++);
+    putU32(f + 4,  millis() / 1000UL);
+    f[8] = (uint8_t)binPct(*dev->bins[0]);
+    f[9] = (uint8_t)binPct(*dev->bins[1]);
+    putU16(f + 10, (uint16_t)dev->bins[0]->dist);
+    putU16(f + 12, (uint16_t)dev->bins[1]->dist);
+    int sig = getSignal();
+    f[14] = (sig >= 0) ? (uint8_t)sig : 99;
+#if USE_GPS
+    putU32(f + 15, fix ? (uint32_t)(int32_t)(gps.location.lat() * 1e6) : 0);
+    putU32(f + 19, fix ? (uint32_t)(int32_t)(gps.location.lng() * 1e6) : 0);
+#else
+    putU32(f + 15, 0);
+    putU32(f + 19, 0);
+#endif
+    putU16(f + 23, dev->smsSentCount);
+    putU16(f + 25, dev->usTimeoutCount);
+    putU16(f + 27, dev->telemFailCount);
+    f[29] = dev->telemDropCount;
+    putU16(f + 30, DEVICE_ID);
+}
+
+/* -------------------------------------------
+   TELEMETRY: GPRS BEARER (SAPBR profile 1)
+   ------------------------------------------- */
+static bool telemBearerUp()
+{
+    simFlush();
+    sim800.println(F("AT+SAPBR=2,1"));
+    if (simWaitFor("+SAPBR: 1,1", 1000)) return true;
+
+    sim800.println(F("AT+SAPBR=3,1,\"CONTYPE\",\"GPRS\""));
+    if (!simWaitFor("OK", 1000)) return false;
+    sim800.print(F("AT+SAPBR=3,1,\"APN\",\""));
+    sim800.print(TELEM_APN);
+    sim800.println(F("\""));
+    if (!simWaitFor("OK", 1000)) return false;
+    sim800.println(F("AT+SAPBR=1,1"));
+    return simWaitFor("OK", 15000);
+}
+
+/* -------------------------------------------
+   TELEMETRY: POST ALL QUEUED FRAMES
+   One HTTP POST, body = frames back to back.
+   Queue only cleared on HTTP 200.
+   ------------------------------------------- */
+bool telemPost()
+{
+    if (dev->telemCount == 0) return true;
+    if (!telemBearerUp()) return false;
+
+    uint16_t len = (uint16_t)dev->telemCount * TELEM_FRAME_LEN;
+    const uint8_t* oldest = dev->telemQueue[dev->telemHead];
+    uint32_t age = millis() / 1000UL -
+                   ((uint32_t)oldest[4]         | ((uint32_t)oldest[5] << 8) |
+                    ((uint32_t)oldest[6] << 16) | ((uint32_t)oldest[7] << 24));
+    bool ok = false;
+    int status = -1;
+
+    sim800.println(F("AT+HTTPTERM"));  simWaitFor("OK", 500);
+    sim800.println(F("AT+HTTPINIT"));
+    if (!simWaitFor("OK", 1000)) return false;
+    sim800.println(F("AT+HTTPPARA=\"CID\",1"));
+    simWaitFor("OK", 1000);
+    sim800.print(F("AT+HTTPPARA=\"URL\",\""));
+    sim800.print(TELEM_URL);
+    sim800.println(F("\""));
+    simWaitFor("OK", 1000);
+    sim800.println(F("AT+HTTPPARA=\"CONTENT\",\"application/octet-stream\""));
+    simWaitFor("OK", 1000);
+
+    sim800.print(F("AT+HTTPDATA="));
+    sim800.print(len);
+    sim800.println(F(",5000"));
+    if (simWaitFor("DOWNLOAD", 2000)) {
+        for (uint8_t i = 0; i < dev->telemCount; i++)
+            sim800.write(dev->telemQueue[(dev->telemHead + i) % TELEM_QUEUE_LEN], TELEM_FRAME_LEN);
+        if (simWaitFor("OK", 5000)) {
+            sim800.println(F("AT+HTTPACTION=1"));
+            if (simWaitFor("+HTTPACTION: 1,", 30000)) {
+                status = simReadInt(1000);
+                ok = (status == 200);
+            }
         }
+    }
+    sim800.println(F("AT+HTTPTERM"));
+    simWaitFor("OK", 500);
+
+    if (ok) {
+        dev->telemBytesSent += len;
+        dev->telemLastOK     = millis();
+        dev->telemHead       = 0;
+        dev->telemCount      = 0;
+        dev->telemDropCount  = 0;
+    }
+    if (DEBUG_MODE) {
+        Serial.print(F("[GPRS] POST "));
+        Serial.print(len);
+        Serial.print(F("B status "));
+        Serial.print(status);
+        Serial.print(F(" oldest "));
+        Serial.print(age);
+        Serial.println(F("s"));
+    }
+    return ok;
+}
+
+#endif // TELEM_ENABLED
+
+/* -------------------------------------------
+   TELEMETRY: SCHEDULER
+   ------------------------------------------- */
+void updateTelemetry()
+{
+#if TELEM_ENABLED
+    unsigned long now = millis();
+
+    if (now - dev->lastTelemSample >= TELEM_SAMPLE_MS) {
+        dev->lastTelemSample = now;
+        telemSample();
+    }
+
+    // Degraded modem: frames stay queued, no GPRS attempt to time out
+    if (now - dev->lastTelemPost >= TELEM_POST_MS && subOK(SUB_MODEM)) {
+        dev->lastTelemPost = now;
+        if (!telemPost()) dev->telemFailCount++;
+    }
+#endif
+}
+
+/* -------------------------------------------
+   WATCHDOG
+   ------------------------------------------- */
+void wdtKick()
+{
+#if USE_WATCHDOG
+    wdt_reset();
+#endif
+}
+
+#if USE_WATCHDOG
+/* Runs from .init3, before main(). After a
+   watchdog reset WDRF keeps the watchdog on
+   at 16ms, and wdt_disable() cannot turn it
+   off until WDRF is cleared; waiting for
+   setup() would reset the board again. */
+#if defined(__AVR__)
+__attribute__((naked, used, section(".init3")))
+#endif
+void wdtBootInit()
+{
+    MCUSR = 0;
+    wdt_disable();
+}
+#endif
+
+/* -------------------------------------------
+   PERSISTENT STATE (.noinit RAM)
+   Saved every loop, restored after a warm
+   reset so a reboot does not unlock a full
+   bin or restart its SMS reminders.
+   ------------------------------------------- */
+static uint8_t persistCheck()
+{
+    const uint8_t* p = (const uint8_t*)&persist;
+    uint8_t sum = 0xA5;
+    for (uint8_t i = 0; i < sizeof(persist) - 1; i++) sum += p[i];
+    return sum;
+}
+
+void persistSave()
+{
+    persist.magic  = PERSIST_MAGIC;
+    persist.flags  = 0;
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        if (dev->bins[i]->locked) persist.flags |= 1 << i;
+        persist.sms[i] = (uint8_t)dev->bins[i]->smsCount;
+    }
+    persist.reboots = healthReboots;
+    persist.reason = 0xFF;
+    persist.check  = persistCheck();
+}
+
+bool persistLoad()
+{
+    bool ok = (persist.magic == PERSIST_MAGIC && persist.check == persistCheck());
+    if (ok) {
+        for (uint8_t i = 0; i < BIN_COUNT; i++) {
+            dev->bins[i]->locked   = persist.flags & (1 << i);
+            dev->bins[i]->smsCount = persist.sms[i];
+        }
+        healthReboots   = persist.reboots;
+        if (DEBUG_MODE) {
+            Serial.print(F("Warm reset, reason "));
+            Serial.print(persist.reason);
+            Serial.println(F(" - state restored"));
+        }
+    }
+    persist.magic = 0;
+    return ok;
+}
+
+void softReboot(uint8_t reason)
+{
+#if USE_WATCHDOG
+    persistSave();
+    persist.reboots = ++healthReboots;
+    persist.reason  = reason;
+    persist.check   = persistCheck();
+    if (DEBUG_MODE) { Serial.print(F("!!! Reboot, subsystem ")); Serial.println(reason); Serial.flush(); }
+    wdt_enable(WDTO_15MS);
+    for (;;) {}
+#endif
+}
+
+/* -------------------------------------------
+   SMS LOG (EEPROM)
+   Degraded mode for the modem: alerts are
+   kept here and summarised by SMS once the
+   modem is healthy again.
+   ------------------------------------------- */
+void smsLog(const char* msg)
+{
+    uint8_t n    = EEPROM.read(EE_SMS_LOG);
+    uint8_t head = EEPROM.read(EE_SMS_LOG_HEAD);
+    if (n > SMS_LOG_LEN || head >= SMS_LOG_LEN) n = head = 0;   // blank / erased EEPROM
+    int addr = EE_SMS_LOG_DATA + head * SMS_LOG_ENTRY;
+
+    uint8_t t[4];
+    putU32(t, millis() / 1000UL);
+    for (uint8_t i = 0; i < 4; i++) EEPROM.update(addr + i, t[i]);
+    for (uint8_t i = 0; i < SMS_LOG_ENTRY - 4; i++) {
+        char c = *msg ? *msg++ : '\0';
+        EEPROM.update(addr + 4 + i, c == '\n' ? ' ' : c);
+    }
+    EEPROM.update(EE_SMS_LOG_HEAD, (head + 1) % SMS_LOG_LEN);    // full: oldest is overwritten
+    if (n < SMS_LOG_LEN) EEPROM.update(EE_SMS_LOG, n + 1);
+    smsLogPending = true;
+}
+
+static void smsLogFlush()
+{
+    uint8_t n    = EEPROM.read(EE_SMS_LOG);
+    uint8_t head = EEPROM.read(EE_SMS_LOG_HEAD);
+    if (n == 0 || n > SMS_LOG_LEN || head >= SMS_LOG_LEN) { smsLogPending = false; return; }
+
+    String msg = F("MODEM BACK: ");
+    msg += n;
+    msg += F(" alert(s) logged offline. Last:\n");
+    int addr = EE_SMS_LOG_DATA + ((head + SMS_LOG_LEN - 1) % SMS_LOG_LEN) * SMS_LOG_ENTRY + 4;
+    for (uint8_t i = 0; i < SMS_LOG_ENTRY - 4; i++) {
+        char c = EEPROM.read(addr + i);
+        if (!c) break;
+        msg += c;
+    }
+    smsLogFlushing = true;
+    if (sendSMS(msg.c_str())) {
+        EEPROM.update(EE_SMS_LOG, 0);
+        smsLogPending = false;
+    }
+    smsLogFlushing = false;
+}
+
+/* -------------------------------------------
+   CALIBRATION (EEPROM)
+   depth/full captured with CMD_CAL replace
+   the BIO_/NON_ macros. The unlock threshold
+   keeps the macro hysteresis above full.
+   ------------------------------------------- */
+struct CalRecord {
+    uint16_t magic;
+    struct { uint16_t depth, full; } bin[BIN_COUNT];
+    uint8_t  check;
+};
+
+static uint8_t calCheck(const CalRecord &c)
+{
+    const uint8_t* p = (const uint8_t*)&c;
+    uint8_t sum = 0xA5;
+    for (uint8_t i = 0; i < sizeof(c) - 1; i++) sum += p[i];
+    return sum;
+}
+
+static bool calValid(const BinState &b, long depth, long full)
+{
+    return depth - full >= CAL_MIN_SPAN_CM && full + b.hystCm < depth;
+}
+
+static void calApply(BinState &b, long depth, long full)
+{
+    b.depthCm = depth;
+    b.fullCm  = full;
+    b.emptyCm = full + b.hystCm;
+}
+
+bool calLoad()
+{
+    CalRecord c;
+    EEPROM.get(EE_CAL, c);
+    if (c.magic != EE_CAL_MAGIC || c.check != calCheck(c)) return false;
+    for (uint8_t i = 0; i < BIN_COUNT; i++)
+        if (!calValid(*dev->bins[i], c.bin[i].depth, c.bin[i].full)) return false;
+    for (uint8_t i = 0; i < BIN_COUNT; i++)
+        calApply(*dev->bins[i], c.bin[i].depth, c.bin[i].full);
+    return true;
+}
+
+#if USE_CONSOLE
+static void calSave()
+{
+    CalRecord c;
+    c.magic = EE_CAL_MAGIC;
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        c.bin[i].depth = (uint16_t)dev->bins[i]->depthCm;
+        c.bin[i].full  = (uint16_t)dev->bins[i]->fullCm;
+    }
+    c.check = calCheck(c);
+    EEPROM.put(EE_CAL, c);
+}
+#endif
+
+/* -------------------------------------------
+   HEALTH: SCORE + HEARTBEAT
+   ------------------------------------------- */
+bool subOK(uint8_t sub)
+{
+    return health[sub].penalty < HEALTH_DEGRADED;
+}
+
+void healthReport(uint8_t sub, bool ok)
+{
+    Health &h = health[sub];
+    if (ok) {
+        if (h.downSince && DEBUG_MODE) {
+            Serial.print(F("[HEALTH] sub ")); Serial.print(sub);
+            Serial.print(F(" recovered after "));
+            Serial.print(millis() - h.downSince); Serial.println(F("ms"));
+        }
+        if (h.penalty >= HEALTH_DEGRADED)   // back: stop re-inits and SMS diversion now
+            h.penalty = HEALTH_DEGRADED - HEALTH_FAIL_STEP;
+        else
+            h.penalty = h.penalty > HEALTH_OK_STEP ? h.penalty - HEALTH_OK_STEP : 0;
+        h.recoveries = 0;
+        h.lastOK     = millis();
+        h.downSince  = 0;
+    } else {
+        h.penalty = (h.penalty + HEALTH_FAIL_STEP > HEALTH_MAX) ? HEALTH_MAX
+                                                                : h.penalty + HEALTH_FAIL_STEP;
+        h.fails++;
+        if (!h.downSince) h.downSince = millis() | 1;
+    }
+}
+
+#if USE_LCD
+static bool i2cPresent(uint8_t addr)
+{
+    Wire.beginTransmission(addr);
+    return halProbe(addr, Wire.endTransmission()) == 0;
+}
+#endif
 
-        // ---- NON-BIO LCD (lcd2) ----
-        lcd2.clear();
-        lcd2.setCursor(0, 0);
-        lcd2.print(F("NON-BIO     "));
-        if      (np < 10)  lcd2.print(F("  "));
-        else if (np < 100) lcd2.print(F(" "));
-        lcd2.print(np);
-        lcd2.print('%');
-
-        lcd2.setCursor(0, 1);
-        lcd2.print(levelBar(np));
-        if (nonLocked) {
-            lcd2.print(F(" FULL "));
+#if USE_MODEM
+static bool modemBooting = false;       // CFUN reset sent, re-init at next check
+
+static void modemReset()
+{
+    if (DEBUG_MODE) Serial.println(F("[HEALTH] modem reset"));
+    simFlush();
+    sim800.println(F("AT+CFUN=1,1"));
+    modemBooting = true;
+}
+#endif
+
+/* -------------------------------------------
+   HEALTH: RECOVERY STAGES
+   ------------------------------------------- */
+static void recover(uint8_t sub)
+{
+    Health &h = health[sub];
+    bool rebootable = false;
+    h.recoveries++;
+    wdtKick();
+
+    switch (sub) {
+#if USE_LCD
+    case SUB_LCD:   initLCD();  rebootable = true; break;
+#endif
+#if USE_RFID
+    case SUB_RFID:  initRFID(); rebootable = true; break;
+#endif
+#if USE_LIGHT
+    case SUB_LIGHT: initLight(); break;
+#endif
+#if USE_MODEM
+    case SUB_MODEM:
+        if (h.recoveries % MODEM_RESET_AFTER == 0) modemReset();
+        else                                        initModem(0);
+        rebootable = true;
+        break;
+#endif
+    default:        // ultrasonic, GPS: nothing to re-init
+        break;
+    }
+    wdtKick();
+
+    if (rebootable && h.recoveries >= REBOOT_AFTER && healthReboots < MAX_HEALTH_REBOOTS)
+        softReboot(sub);
+}
+
+/* -------------------------------------------
+   HEALTH: PERIODIC CHECKS
+   ------------------------------------------- */
+void checkHealth()
+{
+    static unsigned long lastCheck = 0;
+    if (millis() - lastCheck < HEALTH_CHECK_MS) return;
+    lastCheck = millis();
+    bool modemAnswered = false;
+
+#if USE_LCD
+    healthReport(SUB_LCD, i2cPresent(0x27) && i2cPresent(0x25));
+#endif
+#if USE_MODEM
+    if (modemBooting) {                 // reset at the last check: settings lost
+        modemBooting  = false;
+        modemAnswered = initModem(0);
+    } else {
+        simFlush();
+        sim800.println(F("AT"));
+        modemAnswered = simWaitFor("OK", 500);
+    }
+    healthReport(SUB_MODEM, modemAnswered);
+#endif
+#if USE_RFID
+    uint8_t vb = halProbe(PROBE_SPI | PIN_RFID_BIO_SS, rfidBio.PCD_ReadRegister(MFRC522::VersionReg));
+    uint8_t vn = halProbe(PROBE_SPI | PIN_RFID_NON_SS, rfidNonBio.PCD_ReadRegister(MFRC522::VersionReg));
+    healthReport(SUB_RFID, vb != 0x00 && vb != 0xFF && vn != 0x00 && vn != 0xFF);
+#endif
+#if USE_GPS
+    static uint32_t lastChars = 0;
+    healthReport(SUB_GPS, gps.charsProcessed() != lastChars);
+    lastChars = gps.charsProcessed();
+#endif
+
+    for (uint8_t i = 0; i < SUB_COUNT; i++)
+        if (!subOK(i)) recover(i);
+
+    // Only after a good answer: a failing modem can still score OK
+    if (USE_MODEM && smsLogPending && modemAnswered && subOK(SUB_MODEM)) smsLogFlush();
+}
+
+#if USE_CONSOLE
+/* -------------------------------------------
+   CONSOLE: COMMANDS
+   ------------------------------------------- */
+static void conError(uint8_t cmd, uint8_t err)
+{
+    uint8_t e[2] = { cmd, err };
+    conSend(RSP_ERROR, e, 2);
+}
+
+/* -------------------------------------------
+   CONSOLE: COUNTERS REPLY (little-endian)
+    0 u32  uptime (ms)      17 u16 console frames OK
+    4 u16  SMS sent         19 u16 console frames bad
+    6 u16  US timeouts      21 u16 loop max (ms)
+    8 u16  upload fails     23 u8  x SUB_COUNT health
+   10 u32  GPS chars
+   14 u16  GPS bad checksums
+   16 u8   UART RX high water (63 = overrun)
+   RX high water and loop max reset on read.
+   ------------------------------------------- */
+static void conCounters()
+{
+    uint8_t r[23 + SUB_COUNT];
+    putU32(r,      millis());
+    putU16(r + 4,  dev->smsSentCount);
+    putU16(r + 6,  dev->usTimeoutCount);
+    putU16(r + 8,  dev->telemFailCount);
+#if USE_GPS
+    putU32(r + 10, gps.charsProcessed());
+    putU16(r + 14, (uint16_t)gps.failedChecksum());
+#else
+    putU32(r + 10, 0);
+    putU16(r + 14, 0);
+#endif
+    r[16] = rxHighWater;
+    putU16(r + 17, conFrames);
+    putU16(r + 19, conBadFrames);
+    putU16(r + 21, conLoopMax);
+    for (uint8_t i = 0; i < SUB_COUNT; i++) r[23 + i] = HEALTH_MAX - health[i].penalty;
+    rxHighWater = 0;
+    conLoopMax  = 0;
+    conSend(CMD_COUNTERS | RSP_FLAG, r, sizeof(r));
+}
+
+/* One raw echo, no median or retry */
+static uint16_t conPing(uint8_t trig, uint8_t echo)
+{
+    digitalWrite(trig, LOW);  delayMicroseconds(5);
+    digitalWrite(trig, HIGH); delayMicroseconds(10);
+    digitalWrite(trig, LOW);
+    unsigned long us = halEcho(echo, 30000UL);
+    return us > 0xFFFFUL ? 0xFFFF : (uint16_t)us;
+}
+#endif
+
+/* -------------------------------------------
+   CONSOLE: RUN PARKED COMMAND
+   ------------------------------------------- */
+void conService()
+{
+#if USE_CONSOLE
+    if (!conCmdLen) return;
+    uint8_t        cmd = conCmd[0];
+    const uint8_t* a   = conCmd + 1;
+    uint8_t        n   = conCmdLen - 1;
+    BinState*      b   = (n && a[0] < BIN_COUNT) ? dev->bins[a[0]] : 0;
+    uint8_t        r[7];
+    conFrames++;
+
+    switch (cmd) {
+    case CMD_PING:
+        r[0] = CON_VERSION;
+        putU16(r + 1, DEVICE_ID);
+        conSend(cmd | RSP_FLAG, r, 3);
+        break;
+
+    case CMD_COUNTERS:
+        conCounters();
+        break;
+
+    case CMD_STREAM:
+        if (n != 1) { conError(cmd, CON_ERR_ARGS); break; }
+        conStreaming = a[0];
+        r[0] = conStreaming;
+        conSend(cmd | RSP_FLAG, r, 1);
+        break;
+
+    case CMD_CAL: {
+        if (n != 2 || !b || a[1] > CAL_RESET) { conError(cmd, CON_ERR_ARGS); break; }
+        long depth = b->depthCm;
+        long full  = b->fullCm;
+        if (a[1] == CAL_RESET) {
+            depth = b->defDepthCm;
+            full  = b->defFullCm;
         } else {
-            lcd2.print(F(" "));
-            if      (nonDist < 10)  lcd2.print(F("  "));
-            else if (nonDist < 100) lcd2.print(F(" "));
-            lcd2.print(nonDist);
-            lcd2.print(F("cm"));
+            long d = readDist(b->trig, b->echo);
+            if (d >= 999L) { conError(cmd, CON_ERR_SENSOR); break; }
+            if (a[1] == CAL_EMPTY) depth = d;
+            else                   full  = d;
         }
+        if (!calValid(*b, depth, full)) { conError(cmd, CON_ERR_RANGE); break; }
+        calApply(*b, depth, full);
+        calSave();
+        r[0] = a[0];
+        putU16(r + 1, (uint16_t)b->depthCm);
+        putU16(r + 3, (uint16_t)b->fullCm);
+        putU16(r + 5, (uint16_t)b->emptyCm);
+        conSend(cmd | RSP_FLAG, r, 7);
+        if (DEBUG_MODE) { Serial.print(F("[CAL] ")); Serial.print(b->label);
+                          Serial.print(F(" empty=")); Serial.print(b->depthCm);
+                          Serial.print(F("cm full=")); Serial.print(b->fullCm); Serial.println(F("cm")); }
+        break;
     }
+
+#if USE_SERVO
+    case CMD_SERVO: {
+        if (n != 2 || !b || (a[1] > 180 && a[1] != 0xFF)) { conError(cmd, CON_ERR_ARGS); break; }
+        uint8_t deg = (a[1] == 0xFF) ? (b->locked ? SERVO_LOCKED : SERVO_UNLOCKED) : a[1];
+        b->servo->write(deg);
+        r[0] = a[0];
+        r[1] = deg;
+        conSend(cmd | RSP_FLAG, r, 2);
+        break;
+    }
+#endif
+
+    default:
+        conError(cmd, CON_ERR_CMD);
+        break;
+    }
+    conCmdLen = 0;
+#endif
 }
 
 /* -------------------------------------------
-   SETUP
+   CONSOLE: LIVE SENSOR STREAM
+   One raw echo per sensor every CON_STREAM_MS
+   while CMD_STREAM is on. Also called from the
+   idle wait, so the rate holds when the loop
+   body is short.
    ------------------------------------------- */
-void setup()
+void conStream()
+{
+#if USE_CONSOLE
+    static unsigned long lastSample = 0;
+    if (!conStreaming || millis() - lastSample < CON_STREAM_MS) return;
+    lastSample = millis();
+    uint8_t r[4 + 2 * BIN_COUNT];
+    putU32(r, millis());
+    for (uint8_t i = 0; i < BIN_COUNT; i++)
+        putU16(r + 4 + 2 * i, conPing(dev->bins[i]->trig, dev->bins[i]->echo));
+    conSend(EVT_SAMPLE, r, sizeof(r));
+#endif
+}
+
+/* -------------------------------------------
+   DRIVER INIT - shared by every APP_MODE
+   ------------------------------------------- */
+#if USE_LCD || USE_LIGHT
+static void initWire()
 {
-    Serial.begin(9600);
     Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+    Wire.setWireTimeout(3000, true);    // a stuck bus must not hang loop()
+#endif
+}
+#endif
 
+void initLCD()
+{
+#if USE_LCD
+    initWire();
     lcd1.init(); lcd1.backlight();
     lcd2.init(); lcd2.backlight();
+#endif
+}
 
-    lcd1.clear();
-    lcd1.setCursor(0, 0); lcd1.print(F("  BIO  WASTE    "));
-    lcd1.setCursor(0, 1); lcd1.print(F(" Initializing.. "));
-
-    lcd2.clear();
-    lcd2.setCursor(0, 0); lcd2.print(F(" NON-BIO WASTE  "));
-    lcd2.setCursor(0, 1); lcd2.print(F(" Initializing.. "));
-
+void initRFID()
+{
+#if USE_RFID
     SPI.begin();
     rfidBio.PCD_Init();    delay(10);
     rfidNonBio.PCD_Init(); delay(10);
+#endif
+}
 
-    pinMode(PIN_BUZZER,    OUTPUT);
-    pinMode(PIN_RELAY_LED, OUTPUT); digitalWrite(PIN_RELAY_LED, LOW);
+void initUltrasonic()
+{
     pinMode(PIN_TRIG_BIO,  OUTPUT); pinMode(PIN_ECHO_BIO, INPUT);
     pinMode(PIN_TRIG_NON,  OUTPUT); pinMode(PIN_ECHO_NON, INPUT);
+}
 
-    // Boot: LOCKED(90) then OPEN(0) for guaranteed physical movement
-    servoBio.attach(PIN_SERVO_BIO);
-    servoBio.write(SERVO_LOCKED);   delay(800);
-    servoBio.write(SERVO_UNLOCKED); delay(800);
+#if USE_SERVO
+/* Cold boot: LOCKED(90) then OPEN(0) for guaranteed physical
+   movement. Warm boot (state restored): straight to the restored
+   angle, so a full bin stays shut through a reset. */
+static void initServo(Servo &srv, uint8_t pin, bool warm, bool locked)
+{
+    srv.attach(pin);
+    if (warm) { srv.write(locked ? SERVO_LOCKED : SERVO_UNLOCKED); return; }
+    srv.write(SERVO_LOCKED);   delay(800);
+    srv.write(SERVO_UNLOCKED); delay(800);
+}
+#endif
 
-    servoNon.attach(PIN_SERVO_NON);
-    servoNon.write(SERVO_LOCKED);   delay(800);
-    servoNon.write(SERVO_UNLOCKED); delay(800);
+void initServos(bool warm)
+{
+#if USE_SERVO
+    initServo(servoBio, PIN_SERVO_BIO, warm, binBio.locked);
+    initServo(servoNon, PIN_SERVO_NON, warm, binNon.locked);
+#endif
+}
 
-    if (lightMeter.begin(BH1750::CONTINUOUS_HIGH_RES_MODE)) {
+void initLight()
+{
+#if USE_LIGHT
+    initWire();
+    if (halProbe(PROBE_BH1750, lightMeter.begin(BH1750::CONTINUOUS_HIGH_RES_MODE))) {
         lightSensorOK = true;
         if (DEBUG_MODE) Serial.println(F("BH1750 OK"));
     } else {
         if (DEBUG_MODE) Serial.println(F("BH1750 not found - LED manual"));
     }
+#endif
+}
 
+/* AT until it answers (autobaud, or still booting) for up to
+   bootMs, then SMS text mode. Every command waits for its OK
+   rather than a fixed delay, so a dead modem costs one AT wait. */
+bool initModem(unsigned long bootMs)
+{
+#if USE_MODEM
     sim800.begin(9600);
-    delay(3000);
-    sim800.println(F("AT"));                   delay(500);
-    sim800.println(F("ATE0"));                delay(500);
-    sim800.println(F("AT+CMGF=1"));           delay(500);
-    sim800.println(F("AT+CSCS=\"GSM\""));     delay(500);
-    sim800.println(F("AT+CSMP=17,167,0,0"));  delay(500);
+    unsigned long t0 = millis();
+    bool ok;
+    do {
+        ok = modemCmd(F("AT"));
+    } while (!ok && millis() - t0 < bootMs);
+    return ok && modemCmd(F("ATE0")) && modemCmd(F("AT+CMGF=1")) &&
+           modemCmd(F("AT+CSCS=\"GSM\"")) && modemCmd(F("AT+CSMP=17,167,0,0"));
+#else
+    return false;
+#endif
+}
+
+#if APP_MODE == APP_BIN
+/* -------------------------------------------
+   SETUP
+   ------------------------------------------- */
+void setup()
+{
+    // Watchdog already off (wdtBootInit); init below takes longer than WDT_TIMEOUT
+    Serial.begin(9600);
+    bool warm = persistLoad();
+    bool cal  = calLoad();
+    traceBoot(warm);
+
+    initLCD();
+    for (uint8_t i = 0; i < BIN_COUNT; i++)
+        binLCD(*dev->bins[i], dev->bins[i]->title, F(" Initializing.. "));
+
+    initRFID();
+
+    pinMode(PIN_BUZZER,    OUTPUT);
+    pinMode(PIN_RELAY_LED, OUTPUT); digitalWrite(PIN_RELAY_LED, LOW);
+    initUltrasonic();
+
+    initServos(warm);
+    initLight();
+    // No answer at power-up: start degraded, alerts go to the SMS log
+    bool modemUp = initModem(MODEM_POWERUP_MS);
+    if (USE_MODEM && !modemUp) {
+        health[SUB_MODEM].penalty   = HEALTH_DEGRADED;
+        health[SUB_MODEM].downSince = millis() | 1;
+    }
+
+    // Logged alerts from before the reset are flushed once the modem checks OK
+    smsLogPending   = EEPROM.read(EE_SMS_LOG) > 0 && EEPROM.read(EE_SMS_LOG) <= SMS_LOG_LEN &&
+                      EEPROM.read(EE_SMS_LOG_HEAD) < SMS_LOG_LEN;
+    if (warm)
+        for (uint8_t i = 0; i < BIN_COUNT; i++) dev->bins[i]->lastSMSTime = millis();
 
-    dayStart     = millis();
-    lastDailySMS = millis();
+    dev->dayStart        = millis();
+    dev->lastDailySMS    = millis();
+    dev->telemLastOK     = millis();
+#if TELEM_ENABLED
+    dev->lastTelemSample = millis();
+    dev->lastTelemPost   = millis();
+#endif
 
     tone(PIN_BUZZER, 2000, 100); delay(120);
     tone(PIN_BUZZER, 2500, 100);
 
+#if USE_LCD
     lcd1.clear(); lcd2.clear();
+#endif
 
     if (DEBUG_MODE) {
         Serial.println(F("==========================="));
         Serial.println(F("   SMART BIN v3.1 READY"));
         Serial.println(F("==========================="));
-        Serial.print(F("BIO    empty=")); Serial.print(BIO_DEPTH_CM);
-        Serial.print(F("cm  full=")); Serial.print(BIO_FULL_CM);
-        Serial.print(F("cm  usable=")); Serial.print(BIO_USABLE_CM); Serial.println(F("cm"));
-        Serial.print(F("NONBIO empty=")); Serial.print(NON_DEPTH_CM);
-        Serial.print(F("cm  full=")); Serial.print(NON_FULL_CM);
-        Serial.print(F("cm  usable=")); Serial.print(NON_USABLE_CM); Serial.println(F("cm"));
+        Serial.print(F("BIO    empty=")); Serial.print(binBio.depthCm);
+        Serial.print(F("cm  full=")); Serial.print(binBio.fullCm);
+        Serial.print(F("cm  usable=")); Serial.print(binBio.depthCm - binBio.fullCm); Serial.println(F("cm"));
+        Serial.print(F("NONBIO empty=")); Serial.print(binNon.depthCm);
+        Serial.print(F("cm  full=")); Serial.print(binNon.fullCm);
+        Serial.print(F("cm  usable=")); Serial.print(binNon.depthCm - binNon.fullCm); Serial.println(F("cm"));
+        Serial.println(cal ? F("Calibration: EEPROM") : F("Calibration: smart_bin.h"));
         Serial.print(F("Confirm: ")); Serial.print(CONFIRM_NEEDED); Serial.println(F("x reads"));
         Serial.print(F("Interval: ")); Serial.print(US_INTERVAL_MS / 1000); Serial.println(F("s"));
         Serial.println(F("==========================="));
     }
+
+#if USE_WATCHDOG
+    wdt_enable(WDT_TIMEOUT);
+#endif
 }
 
 /* -------------------------------------------
@@ -623,35 +1899,89 @@ void setup()
    ------------------------------------------- */
 void loop()
 {
-    while (Serial.available()) gps.encode(Serial.read());
+    static unsigned long loopMax = 0;
+    unsigned long loopStart = millis();
+    wdtKick();
+    halSerialPoll();
+    conService();
 
     checkRFID();
     updateLight();
     updateDistances();
     checkRepeatSMS();
+    updateTelemetry();
+    checkHealth();
 
-    digitalWrite(PIN_RELAY_LED,
-                 (ambientLEDOn || bioLocked || nonLocked) ? HIGH : LOW);
+    bool anyLocked = false;
+    for (uint8_t i = 0; i < BIN_COUNT; i++) anyLocked |= dev->bins[i]->locked;
+    digitalWrite(PIN_RELAY_LED, (ambientLEDOn || anyLocked) ? HIGH : LOW);
 
     updateLCD();
+    conStream();
+
+    persistSave();
+    if (TRACE_RECORD) traceLoop(loopStart);
+    unsigned long body = millis() - loopStart;
+    if (body > loopMax) loopMax = body;
+#if USE_CONSOLE
+    if (body > conLoopMax) conLoopMax = (unsigned int)body;
+#endif
 
 #if DEBUG_MODE
+    // One line per pass: each fits the 64-byte TX buffer, so the
+    // report never blocks loop() while GPS data is arriving
     static unsigned long lastDbg = 0;
-    if (millis() - lastDbg >= 5000UL) {
+    static uint8_t       dbgLine = 0;
+    if (!dbgLine && millis() - lastDbg >= 5000UL) {
         lastDbg = millis();
+        dbgLine = 1;
+    }
+    switch (dbgLine) {
+    case 1:
         Serial.print(F("BIO "));
-        Serial.print(bioDist); Serial.print(F("cm "));
-        Serial.print(bioPct()); Serial.print(F("% "));
-        Serial.print(bioLocked ? F("LOCKED") : F("open"));
+        Serial.print(binBio.dist); Serial.print(F("cm "));
+        Serial.print(binPct(binBio)); Serial.print(F("% "));
+        Serial.print(binBio.locked ? F("LOCKED") : F("open"));
         Serial.print(F("  | NON-BIO "));
-        Serial.print(nonDist); Serial.print(F("cm "));
-        Serial.print(nonPct()); Serial.print(F("% "));
-        Serial.println(nonLocked ? F("LOCKED") : F("open"));
-        Serial.print(F("Bio SMS today: ")); Serial.print(bioSMSCount);
-        Serial.print(F("  Non SMS today: ")); Serial.println(nonSMSCount);
+        Serial.print(binNon.dist); Serial.print(F("cm "));
+        Serial.print(binPct(binNon)); Serial.print(F("% "));
+        Serial.println(binNon.locked ? F("LOCKED") : F("open"));
+        break;
+    case 2:
+        Serial.print(F("Bio SMS today: ")); Serial.print(binBio.smsCount);
+        Serial.print(F("  Non SMS today: ")); Serial.println(binNon.smsCount);
+        break;
+    case 3:
         if (lightSensorOK) { Serial.print(F("Lux: ")); Serial.println(currentLux); }
+        break;
+    case 4:
+        if (TELEM_ENABLED) {
+            Serial.print(F("GPRS sent: ")); Serial.print(dev->telemBytesSent);
+            Serial.print(F("B  fails: ")); Serial.println(dev->telemFailCount);
+        }
+        break;
+    case 5:
+        Serial.print(F("Health LCD/MDM/RFID/LUX/GPS/USB/USN:"));
+        for (uint8_t i = 0; i < SUB_COUNT; i++) {
+            Serial.print(' ');
+            Serial.print(HEALTH_MAX - health[i].penalty);
+        }
+        Serial.println();
+        break;
+    case 6:
+        Serial.print(F("Loop max: ")); Serial.print(loopMax); Serial.println(F("ms"));
+        loopMax = 0;
+        break;
     }
+    if (dbgLine) dbgLine = dbgLine < 6 ? dbgLine + 1 : 0;
 #endif
 
-    delay(100);
-}
\ No newline at end of file
+    // Idle with the UART drained: its 64-byte RX buffer only holds
+    // ~66ms of GPS data at 9600 baud, less than a bare delay(100)
+    unsigned long idle = millis();
+    while (millis() - idle < 100UL) {
+        halSerialPoll();
+        conStream();
+    }
+}
+#endif // APP_MODE == APP_BIN
\ No newline at end of file
@@ -11,14 +11,90 @@
  */
 
 #include <Arduino.h>
+
+/* -------------------------------------------
+   APPLICATION
+   APP_BIN         smart bin firmware
+   APP_MODEM_TEST  SIM800 self-test + SMS
+   APP_SERVO_TEST  lock/unlock console
+   APP_GPS_TEST    GPS fix on LCD + Serial
+   All apps share the drivers below.
+   ------------------------------------------- */
+#define APP_BIN             0
+#define APP_MODEM_TEST      1
+#define APP_SERVO_TEST      2
+#define APP_GPS_TEST        3
+
+#ifndef APP_MODE
+#define APP_MODE            APP_BIN
+#endif
+
+/* -------------------------------------------
+   MODULE SELECTION
+   false = driver, object and library are
+   compiled out. Ultrasonic is always in.
+   Any of these can also be set with -D.
+   ------------------------------------------- */
+#ifndef USE_LCD
+#define USE_LCD             true
+#endif
+#ifndef USE_GPS
+#define USE_GPS             true
+#endif
+#ifndef USE_MODEM
+#define USE_MODEM           true
+#endif
+#ifndef USE_RFID
+#define USE_RFID            true
+#endif
+#ifndef USE_SERVO
+#define USE_SERVO           true
+#endif
+#ifndef USE_LIGHT
+#define USE_LIGHT           true
+#endif
+
+#if APP_MODE == APP_MODEM_TEST && !USE_MODEM
+#error "APP_MODEM_TEST needs USE_MODEM"
+#endif
+#if APP_MODE == APP_SERVO_TEST && !USE_SERVO
+#error "APP_SERVO_TEST needs USE_SERVO"
+#endif
+#if APP_MODE == APP_GPS_TEST && !USE_GPS
+#error "APP_GPS_TEST needs USE_GPS"
+#endif
+
+#ifndef USE_WATCHDOG
+#define USE_WATCHDOG        true
+#endif
+
+#include <EEPROM.h>
+#if USE_WATCHDOG
+#include <avr/io.h>
+#include <avr/wdt.h>
+#endif
+#if USE_GPS
 #include <TinyGPS++.h>
+#endif
+#if USE_LCD || USE_LIGHT
 #include <Wire.h>
+#endif
+#if USE_LCD
 #include <LiquidCrystal_I2C.h>
+#endif
+#if USE_MODEM
 #include <SoftwareSerial.h>
+#endif
+#if USE_LIGHT
 #include <BH1750.h>
+#endif
+#if USE_SERVO
 #include <Servo.h>
+#endif
+#if USE_RFID
 #include <SPI.h>
 #include <MFRC522.h>
+#endif
 
 /* -------------------------------------------
    BIO BIN CALIBRATION
@@ -45,7 +121,9 @@
 /* -------------------------------------------
    GENERAL CONFIG
    ------------------------------------------- */
+#ifndef DEBUG_MODE
 #define DEBUG_MODE          true
+#endif
 
 #define US_INTERVAL_MS      3000UL
 #define CONFIRM_NEEDED      3
@@ -56,6 +134,175 @@
 
 #define LUX_THRESHOLD       50.0f
 
+/* -------------------------------------------
+   GPRS TELEMETRY
+   One binary frame every TELEM_SAMPLE_MS,
+   queued in RAM and POSTed as a batch every
+   TELEM_POST_MS. Frames stay queued while the
+   link is down; oldest dropped when full.
+   SMS alerts are always sent; the daily SMS
+   report is only sent as a fallback when no
+   upload has succeeded for a day.
+   ------------------------------------------- */
+#ifndef TELEM_ENABLED
+#define TELEM_ENABLED       USE_MODEM
+#endif
+#define TELEM_SAMPLE_MS     900000UL
+#define TELEM_POST_MS       3600000UL
+#define TELEM_QUEUE_LEN     8
+#define TELEM_FRAME_LEN     32
+#define TELEM_VERSION       2
+
+/* -------------------------------------------
+   SERIAL CONSOLE
+   Binary commands multiplexed with the GPS on
+   the hardware UART (9600 baud). Frame:
+     00 COBS(type payload crc16) 00
+   crc16 = CRC-16/CCITT-FALSE of type+payload
+   (LE). NMEA never contains 0x00, so bytes
+   outside a frame go to the GPS parser, and
+   a stray 0x00 costs the GPS nothing: the
+   buffered bytes are handed back to it.
+   Replies are type | RSP_FLAG. Trace records
+   use the same framing.
+   ------------------------------------------- */
+#ifndef USE_CONSOLE
+#define USE_CONSOLE         true
+#endif
+#define CON_FRAME_MAX       40    // type + payload + crc16, decoded
+#define CON_VERSION         1
+#define CON_STREAM_MS       100   // EVT_SAMPLE period, ~14 B frame: ~15% of TX
+#define CON_ERR_GAP_MS      250   // CON_ERR_CRC replies at most this often
+
+#define CMD_PING            0x01  // -> u8 CON_VERSION, u16 DEVICE_ID
+#define CMD_COUNTERS        0x02  // -> see conCounters()
+#define CMD_STREAM          0x03  // u8 on -> u8 on, then EVT_SAMPLE every CON_STREAM_MS
+#define CMD_CAL             0x04  // u8 bin, u8 CAL_* -> u8 bin, u16 depth, full, empty (cm)
+#define CMD_SERVO           0x05  // u8 bin, u8 deg (0xFF = lock state) -> u8 bin, u8 deg
+#define RSP_FLAG            0x80
+#define EVT_SAMPLE          0xA0  // u32 ms, u16 BIO echo us, u16 NON echo us (0 = timeout)
+#define RSP_ERROR           0xFF  // u8 cmd, u8 CON_ERR_*
+
+#define CAL_EMPTY           0     // current distance -> depthCm
+#define CAL_FULL            1     // current distance -> fullCm
+#define CAL_RESET           2     // back to the BIO_/NON_ macros
+
+#define CON_ERR_CRC         1
+#define CON_ERR_CMD         2
+#define CON_ERR_ARGS        3
+#define CON_ERR_SENSOR      4     // no echo
+#define CON_ERR_RANGE       5     // depth - full below CAL_MIN_SPAN_CM
+#define CON_ERR_BUSY        6     // previous command not run yet, resend
+
+#define CAL_MIN_SPAN_CM     10
+
+/* -------------------------------------------
+   TRACE RECORDING
+   Streams every HAL input (echo pulse
+   widths, lux, UART bytes from the GPS,
+   console and SIM800, card UIDs, peripheral
+   probes) plus lock/SMS state and a loop
+   time summary as console frames on Serial.
+   host/replay feeds a capture back through
+   the unmodified logic.
+   ------------------------------------------- */
+#ifndef TRACE_RECORD
+#define TRACE_RECORD        false
+#endif
+#define TRACE_VERSION       3
+#define TRACE_BATCH         32    // UART RX bytes per NMEA/MODEM record
+#define TRACE_LOOP_MS       10000UL  // TR_LOOP summary period
+
+#if TELEM_ENABLED && !USE_MODEM
+#error "TELEM_ENABLED needs USE_MODEM"
+#endif
+
+/* Build options in TR_BOOT: a capture only
+   replays on a build with the same ones  */
+#define TRACE_CONFIG        ((USE_LCD << 0) | (USE_GPS << 1) | (USE_MODEM << 2) | \
+                             (USE_RFID << 3) | (USE_SERVO << 4) | (USE_LIGHT << 5) | \
+                             (USE_CONSOLE << 6) | (TELEM_ENABLED << 7) | \
+                             (USE_WATCHDOG << 8) | (DEBUG_MODE << 9))
+
+/* Record: console frame, type = TR_*,
+   payload = dt16 (ms since previous record,
+   LE) then the record payload. Echo and lux
+   are stamped when the reading started.
+   UART bytes are batched, stamped with the
+   last one's read time; a batch also ends
+   at a 0x00 (console frame end) and at
+   every simWaitFor().                    */
+#define TR_BOOT             0x01  // start of setup(), see traceBoot()
+#define TR_ECHO             0x02  // u8 echo pin, u16 pulse us (0 = timeout)
+#define TR_LUX              0x03  // f32 lux
+#define TR_NMEA             0x04  // Serial RX bytes, GPS + console (1-TRACE_BATCH)
+#define TR_CARD             0x05  // u8 reader (0 BIO, 1 NON), UID bytes
+#define TR_MODEM            0x06  // SIM800 RX bytes (1-TRACE_BATCH)
+#define TR_PROBE            0x07  // u8 probe id, u8 result
+#define TR_STATE            0x10  // u8 lock flags, u16 SMS sent (on change)
+#define TR_LOOP             0x11  // u16 loops, u16 body ms min, avg, max (every TRACE_LOOP_MS)
+#define TR_TIME             0x7F  // u32 absolute ms (dt overflow)
+
+/* TR_PROBE id: an I2C address (result =
+   Wire.endTransmission()) or one of:     */
+#define PROBE_SPI           0x80  // | SS pin: MFRC522 version register
+#define PROBE_BH1750        0xFF  // lightMeter.begin(), 1 = found
+
+/* -------------------------------------------
+   WATCHDOG + SUBSYSTEM HEALTH
+   Each subsystem has a penalty (0 = healthy)
+   raised on a failed check, lowered on a good
+   one. The first good check of a degraded
+   subsystem ends degraded mode (penalty set
+   one failure below HEALTH_DEGRADED).
+   Recovery is staged:
+     1. penalty >= HEALTH_DEGRADED: re-init
+        the peripheral every health check
+     2. modem only: every MODEM_RESET_AFTER
+        re-inits, full modem reset (CFUN=1,1).
+        It boots until the next check, which
+        re-inits it instead of sending AT, so
+        loop() never waits for SMS Ready.
+     3. REBOOT_AFTER failed re-inits of an
+        I2C/SPI/UART peripheral: watchdog
+        reboot, lock + SMS state preserved
+   A hung loop() is caught by the watchdog.
+   ------------------------------------------- */
+#define WDT_TIMEOUT         WDTO_8S
+#define HEALTH_CHECK_MS     30000UL
+#define HEALTH_FAIL_STEP    25
+#define HEALTH_OK_STEP      10
+#define HEALTH_DEGRADED     50
+#define HEALTH_MAX          100
+#define MODEM_RESET_AFTER   3
+#define MODEM_OK_MS         500UL    // initModem(): wait for each OK
+#define MODEM_POWERUP_MS    3000UL   // setup(): AT retried this long
+#define REBOOT_AFTER        6
+#define MAX_HEALTH_REBOOTS  3
+
+/* -------------------------------------------
+   EEPROM LAYOUT
+   0..: SMS log - alerts that could not be
+        sent while the modem was down, ring
+        of the last SMS_LOG_LEN
+   258..: bin calibration captured with
+        CMD_CAL, overrides the macros
+   ------------------------------------------- */
+#define EE_SMS_LOG          0     // u8 count (0..SMS_LOG_LEN)
+#define EE_SMS_LOG_HEAD     1     // u8 next slot to write
+#define EE_SMS_LOG_DATA     2     // entries
+#define SMS_LOG_LEN         8
+#define SMS_LOG_ENTRY       32    // u32 uptime s + 28 chars
+#define EE_SMS_LOG_END      (EE_SMS_LOG_DATA + SMS_LOG_LEN * SMS_LOG_ENTRY)
+#define EE_CAL              EE_SMS_LOG_END  // u16 magic, BIO/NON u16 depth + full, u8 check
+#define EE_CAL_MAGIC        0xCA1Bu
+
+/* -------------------------------------------
+   DEVICE ID - unique per bin in the fleet,
+   sent in every telemetry frame
+   ------------------------------------------- */
+#define DEVICE_ID           1
+
 /* -------------------------------------------
    PIN MAP
    ------------------------------------------- */
@@ -92,18 +339,134 @@ static const char AUTH_UID2[] = "F3 37 B3 39";
    ------------------------------------------- */
 static const char PHONE[] = "+639618898492";
 
+/* -------------------------------------------
+   TELEMETRY ENDPOINT
+   ------------------------------------------- */
+static const char TELEM_APN[] = "internet";
+static const char TELEM_URL[] = "http://dispatch.example.com/api/bin";
+
 /* -------------------------------------------
    HARDWARE OBJECT DECLARATIONS
    ------------------------------------------- */
+#if USE_GPS
 extern TinyGPSPlus        gps;
+#endif
+#if USE_LCD
 extern LiquidCrystal_I2C  lcd1;
 extern LiquidCrystal_I2C  lcd2;
+#endif
+#if USE_LIGHT
 extern BH1750             lightMeter;
+#endif
+#if USE_MODEM
 extern SoftwareSerial     sim800;
+#endif
+#if USE_SERVO
 extern Servo              servoBio;
 extern Servo              servoNon;
+#endif
+#if USE_RFID
 extern MFRC522            rfidBio;
 extern MFRC522            rfidNonBio;
+#endif
+
+/* -------------------------------------------
+   PER-BIN STATE
+   One instance per bin, listed in the
+   device's bins[].
+   stepBin() is the fill/lock state machine:
+   it only touches the struct, so any number
+   of bins can be run side by side. Hardware
+   side effects (servo, buzzer, SMS) are in
+   handleBin() and go through the instance's
+   own pins and peripherals, never by which
+   bin it is.
+   ------------------------------------------- */
+#define BIN_COUNT           2     // max 8 (lock flags are one byte)
+
+struct BinState {
+    const char*   label;        // "BIO" / "NON-BIO"
+    const __FlashStringHelper* title;   // LCD line 0, 16 chars
+    uint8_t       sub;          // Subsystem of its ultrasonic sensor
+    uint8_t       trig;
+    uint8_t       echo;
+    long          defDepthCm;   // smart_bin.h calibration (CAL_RESET)
+    long          defFullCm;
+    long          hystCm;       // unlock = full + hyst
+    long          depthCm;      // empty reading
+    long          fullCm;       // lock at or below
+    long          emptyCm;      // unlock at or above
+    long          dist;
+    bool          locked;
+    int           fullCnt;
+    int           emptyCnt;
+    unsigned long lastSMSTime;
+    int           smsCount;
+#if USE_SERVO
+    Servo*        servo;
+#endif
+#if USE_LCD
+    LiquidCrystal_I2C* lcd;
+#endif
+#if USE_RFID
+    MFRC522*      rfid;
+#endif
+};
+
+enum BinEvent {
+    BIN_EVT_NONE,
+    BIN_EVT_FULL,               // just locked
+    BIN_EVT_EMPTIED             // just unlocked by sensor
+};
+
+enum Subsystem {
+    SUB_LCD,
+    SUB_MODEM,
+    SUB_RFID,
+    SUB_LIGHT,
+    SUB_GPS,
+    SUB_US_BIO,
+    SUB_US_NON,
+    SUB_COUNT
+};
+
+struct Health {
+    uint8_t       penalty;      // 0 = healthy, HEALTH_MAX = dead
+    uint8_t       recoveries;   // re-inits since last good check
+    unsigned int  fails;        // failed checks since boot
+    unsigned long lastOK;       // heartbeat
+    unsigned long downSince;    // first failure of current outage
+};
+
+/* -------------------------------------------
+   PER-DEVICE STATE
+   Everything the bin logic and telemetry keep
+   between loop() passes. updateDistances(),
+   checkRepeatSMS(), processCard() and
+   updateTelemetry() work on *dev: the board's
+   own device, or one of many in the fleet
+   simulator.
+   ------------------------------------------- */
+struct Device {
+    BinState*     bins[BIN_COUNT];
+    unsigned long lastUSRead;
+    unsigned long dayStart;
+    unsigned long lastDailySMS;
+    unsigned int  smsSentCount;
+    unsigned int  usTimeoutCount;
+    unsigned int  telemFailCount;
+    uint8_t       telemDropCount;
+    unsigned long telemBytesSent;
+    unsigned long telemLastOK;
+#if TELEM_ENABLED
+    uint8_t       telemQueue[TELEM_QUEUE_LEN][TELEM_FRAME_LEN];
+    uint8_t       telemHead;
+    uint8_t       telemCount;
+    uint16_t      telemSeq;
+    unsigned long lastTelemSample;
+    unsigned long lastTelemPost;
+#endif
+};
 
 /* -------------------------------------------
    STATE VARIABLE DECLARATIONS
@@ -113,45 +476,92 @@ extern float          currentLux;
 extern bool           ambientLEDOn;
 extern unsigned long  lastLuxRead;
 
-extern bool           bioLocked;
-extern bool           nonLocked;
-
-extern long           bioDist;
-extern long           nonDist;
-extern unsigned long  lastUSRead;
+extern BinState       binBio;
+extern BinState       binNon;
+extern Device         device;
+extern Device*        dev;
 
-extern int            bioFullCnt;
-extern int            bioEmptyCnt;
-extern int            nonFullCnt;
-extern int            nonEmptyCnt;
-
-extern unsigned long  bioLastSMSTime;
-extern unsigned long  nonLastSMSTime;
-extern int            bioSMSCount;
-extern int            nonSMSCount;
-extern unsigned long  dayStart;
-extern unsigned long  lastDailySMS;
+extern Health         health[SUB_COUNT];
+extern uint8_t        healthReboots;
 
 /* -------------------------------------------
    FUNCTION DECLARATIONS
    ------------------------------------------- */
-void    sendSMS(const char* msg);
+void    putU16(uint8_t* p, uint16_t v);
+void    putU32(uint8_t* p, uint32_t v);
+
+void    conSend(uint8_t type, const uint8_t* p, uint8_t len);
+void    conService();
+void    conStream();
+
+void    traceWrite(uint8_t type, const uint8_t* p, uint8_t len);
+void    traceFlush();
+unsigned long halEcho(uint8_t echo, unsigned long timeoutUs);
+float   halLux();
+void    halSerialPoll();
+void    halDelay(unsigned long ms);
+uint8_t halProbe(uint8_t id, uint8_t result);
+#if USE_MODEM
+int     halSimRead();
+#endif
+#if USE_RFID
+void    halCard(MFRC522 &r, uint8_t reader);
+#endif
+void    traceBoot(bool warm);
+void    traceLoop(unsigned long loopStart);
+
+bool    sendSMS(const char* msg);
 String  gpsStr();
 int     getSignal();
 long    readDist(uint8_t trig, uint8_t echo);
-int     bioPct();
-int     nonPct();
+int     binPct(const BinState &b);
 String  levelBar(int pct);
+#if USE_SERVO
 void    servoForceOpen(Servo &srv);
+#endif
+void    binServo(BinState &b, bool lock);
+void    binLCD(BinState &b, const __FlashStringHelper* l0, const __FlashStringHelper* l1);
 
+BinEvent stepBin(BinState &b, long dist);
+void    handleBin(BinState &b, long dist);
 void    updateDistances();
+void    remindBin(BinState &b, unsigned long now);
 void    checkRepeatSMS();
 
+#if USE_RFID
 String  getUID(MFRC522 &r);
-void    processCard(String uid, LiquidCrystal_I2C &lcd, bool isBioReader);
+#endif
+void    processCard(String uid, BinState &b);
 void    checkRFID();
 
 void    updateLight();
 void    updateLCD();
 
+bool    subOK(uint8_t sub);
+void    healthReport(uint8_t sub, bool ok);
+void    checkHealth();
+void    wdtKick();
+#if USE_WATCHDOG
+void    wdtBootInit();
+#endif
+void    softReboot(uint8_t reason);
+void    persistSave();
+bool    persistLoad();
+void    smsLog(const char* msg);
+bool    calLoad();
+
+void    initLCD();
+void    initRFID();
+void    initUltrasonic();
+void    initServos(bool warm);
+void    initLight();
+bool    initModem(unsigned long bootMs);
+
+bool    simWaitFor(const char* token, unsigned long timeoutMs);
+int     simReadInt(unsigned long timeoutMs);
+void    simFlush();
+void    telemSample();
+bool    telemPost();
+void    updateTelemetry();
+
 #endif // SMART_BIN_H
\ No newline at end of file
@@ -0,0 +1,430 @@
+#!/usr/bin/env python3
+"""
+SMART WASTE BIN SYSTEM - footprint report
+
+Compiles the smart_bin sketch for AVR with arduino-cli and reports:
+  - flash (.text + .data) and static SRAM (.data + .bss)
+  - per-symbol size breakdown (optionally written as CSV)
+  - worst-case stack per function from -fstack-usage + the call graph
+    taken from the disassembly
+
+Fails (exit 1) when a budget is exceeded, so it can gate a build.
+
+Usage:
+  python3 tools/footprint.py
+  python3 tools/footprint.py --csv footprint.csv --flash-max 30000
+  python3 tools/footprint.py -D DEBUG_MODE=false
+  python3 tools/footprint.py --matrix
+  python3 tools/footprint.py --matrix --host
+
+Needs arduino-cli with the arduino:avr core and the libraries listed in
+README.md installed. avr-size / avr-nm / avr-objdump are taken from PATH
+or from the arduino:avr toolchain under ~/.arduino15.
+
+--host needs only make and g++: each matrix configuration is built for the
+host (host/loop_bench.cpp) and its loop() latency measured on the virtual
+clock. Flash, SRAM and stack are left to an AVR run.
+"""
+
+import argparse
+import csv
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT   = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SKETCH = os.path.join(ROOT, "smart_bin")
+HOST   = os.path.join(ROOT, "host")
+
+# ATmega328P (Uno, optiboot)
+FLASH_TOTAL = 32256
+SRAM_TOTAL  = 2048
+
+# AVR call pushes a 2-byte return address
+RET_ADDR = 2
+
+# Known deep path we always report explicitly
+WATCH_PATHS = [("checkRepeatSMS", "sendSMS")]
+
+
+# -------------------------------------------
+# TOOLCHAIN
+# -------------------------------------------
+def find_tool(name):
+    path = shutil.which(name)
+    if path:
+        return path
+    homes = [os.path.expanduser("~/.arduino15"),
+             os.path.expanduser("~/Library/Arduino15"),
+             os.path.expandvars(r"%LOCALAPPDATA%\Arduino15")]
+    for home in homes:
+        hits = sorted(glob.glob(os.path.join(
+            home, "packages", "arduino", "tools", "avr-gcc", "*", "bin", name + "*")))
+        if hits:
+            return hits[-1]
+    sys.exit("footprint: %s not found (install arduino:avr core)" % name)
+
+
+def run(cmd):
+    try:
+        res = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True)
+    except FileNotFoundError:
+        sys.exit("footprint: %s not found" % cmd[0])
+    if res.returncode != 0:
+        sys.stdout.write(res.stdout)
+        sys.exit("footprint: command failed: %s" % " ".join(cmd))
+    return res.stdout
+
+
+def compile_sketch(build_dir, fqbn, defines, extra):
+    flags = " ".join(["-D" + d for d in defines] + extra)
+    cmd = ["arduino-cli", "compile", "--fqbn", fqbn,
+           "--build-path", build_dir, SKETCH]
+    if flags:
+        for prop in ("compiler.c.extra_flags", "compiler.cpp.extra_flags"):
+            cmd += ["--build-property", "%s=%s" % (prop, flags)]
+    run(cmd)
+    elf = glob.glob(os.path.join(build_dir, "*.elf"))
+    if not elf:
+        sys.exit("footprint: no .elf produced in %s" % build_dir)
+    return elf[0]
+
+
+# -------------------------------------------
+# SECTIONS + SYMBOLS
+# -------------------------------------------
+def section_sizes(elf):
+    sizes = {}
+    for line in run([find_tool("avr-size"), "-A", elf]).splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sizes[parts[0]] = int(parts[1])
+    return sizes
+
+
+def symbols(elf):
+    out = []
+    for line in run([find_tool("avr-nm"), "-C", "-S", "--size-sort", elf]).splitlines():
+        m = re.match(r"^[0-9a-f]+ ([0-9a-f]+) (\w) (.+)$", line)
+        if not m:
+            continue
+        size = int(m.group(1), 16)
+        kind = m.group(2).lower()
+        if kind in "tw":
+            region = "flash"
+        elif kind in "dbv":
+            region = "sram"
+        else:
+            region = "other"
+        out.append((m.group(3), region, kind, size))
+    out.sort(key=lambda s: -s[3])
+    return out
+
+
+# -------------------------------------------
+# STACK: -fstack-usage + CALL GRAPH
+# -------------------------------------------
+CLONE_RE = re.compile(r"\.(constprop|isra|part|cold|lto_priv)\.\d+")
+
+
+def base_name(sig):
+    """'void sendSMS(const char*)' / 'sendSMS(char const*)' -> 'sendSMS'"""
+    sig = CLONE_RE.sub("", sig)
+    head = sig.split("(", 1)[0].strip()
+    return head.split(" ")[-1] if head else sig
+
+
+def stack_usage(build_dir):
+    frames = {}
+    dynamic = set()
+    for su in glob.glob(os.path.join(build_dir, "**", "*.su"), recursive=True):
+        with open(su) as f:
+            for line in f:
+                parts = line.rstrip("\n").split("\t")
+                if len(parts) < 3:
+                    continue
+                m = re.match(r"^.*:\d+:\d+:(.*)$", parts[0])
+                name = base_name(m.group(1) if m else parts[0])
+                frames[name] = max(frames.get(name, 0), int(parts[1]))
+                if parts[2] != "static":
+                    dynamic.add(name)
+    return frames, dynamic
+
+
+def call_graph(elf):
+    graph = {}
+    indirect = set()
+    cur = None
+    dis = run([find_tool("avr-objdump"), "-d", "-C", elf])
+    for line in dis.splitlines():
+        m = re.match(r"^[0-9a-f]+ <(.+)>:$", line)
+        if m:
+            cur = base_name(m.group(1))
+            graph.setdefault(cur, set())
+            continue
+        if cur is None:
+            continue
+        if re.search(r"\t(e?icall|e?ijmp)\b", line):
+            indirect.add(cur)
+            continue
+        m = re.search(r"\t(r?call|r?jmp)\t.*<([^>]+)>", line)
+        if m and "+0x" not in m.group(2):
+            target = base_name(m.group(2))
+            if target != cur:
+                graph[cur].add((target, m.group(1).endswith("call")))
+    return graph, indirect
+
+
+def worst_stack(graph, frames):
+    """Returns {func: (bytes, path)} - deepest chain starting at func."""
+    memo = {}
+
+    def visit(fn, active):
+        if fn in memo:
+            return memo[fn]
+        if fn in active:                      # recursion: unbounded
+            return (0, [fn + " (recursive)"])
+        active.add(fn)
+        best = (0, [])
+        for callee, is_call in graph.get(fn, ()):
+            depth, path = visit(callee, active)
+            depth += RET_ADDR if is_call else 0
+            if depth > best[0]:
+                best = (depth, path)
+        active.discard(fn)
+        memo[fn] = (frames.get(fn, 0) + best[0], [fn] + best[1])
+        return memo[fn]
+
+    for fn in graph:
+        visit(fn, set())
+    return memo
+
+
+def path_depth(graph, frames, src, dst):
+    """Deepest stack on any call chain from src that reaches dst."""
+    memo = {}
+
+    def visit(fn, active):
+        if fn == dst:
+            return (frames.get(fn, 0), [fn])
+        if fn in memo:
+            return memo[fn]
+        if fn in active:
+            return None
+        active.add(fn)
+        best = None
+        for callee, is_call in graph.get(fn, ()):
+            sub = visit(callee, active)
+            if sub is None:
+                continue
+            depth = sub[0] + (RET_ADDR if is_call else 0)
+            if best is None or depth > best[0]:
+                best = (depth, sub[1])
+        active.discard(fn)
+        memo[fn] = None if best is None else (frames.get(fn, 0) + best[0], [fn] + best[1])
+        return memo[fn]
+
+    return visit(src, set())
+
+
+# -------------------------------------------
+# BUILD + MEASURE ONE CONFIGURATION
+# -------------------------------------------
+def measure(work, fqbn, defines):
+    size_dir  = os.path.join(work, "size")
+    stack_dir = os.path.join(work, "stack")
+
+    # Sizes from the normal (LTO) build; stack from a non-LTO build,
+    # because .su files are only written when code is generated per TU.
+    elf = compile_sketch(size_dir, fqbn, defines, [])
+    stack_elf = compile_sketch(stack_dir, fqbn, defines,
+                               ["-fstack-usage", "-fno-lto"])
+
+    sec    = section_sizes(elf)
+    text   = sec.get(".text", 0)
+    data   = sec.get(".data", 0)
+    bss    = sec.get(".bss", 0)
+    noinit = sec.get(".noinit", 0)
+
+    frames, dynamic = stack_usage(stack_dir)
+    graph, indirect = call_graph(stack_elf)
+    worst = worst_stack(graph, frames)
+
+    main_stack = worst.get("main", (0, ["main"]))
+    isr_stack  = (0, [])
+    for fn, val in worst.items():
+        if fn.startswith("__vector_") and val[0] > isr_stack[0]:
+            isr_stack = val
+    stack = main_stack[0] + isr_stack[0] + (RET_ADDR if isr_stack[0] else 0)
+
+    return {"elf": elf, "text": text, "data": data, "bss": bss, "noinit": noinit,
+            "flash": text + data, "sram": data + bss + noinit, "stack": stack,
+            "main_stack": main_stack, "isr_stack": isr_stack,
+            "frames": frames, "dynamic": dynamic, "indirect": indirect,
+            "graph": graph, "worst": worst}
+
+
+# Module configurations compared by --matrix
+MATRIX = [
+    ("full",         []),
+    ("no debug",     ["DEBUG_MODE=false"]),
+    ("no telemetry", ["DEBUG_MODE=false", "TELEM_ENABLED=false"]),
+    ("no modem",     ["DEBUG_MODE=false", "USE_MODEM=false"]),
+    ("no lcd",       ["DEBUG_MODE=false", "USE_LCD=false"]),
+    ("no gps",       ["DEBUG_MODE=false", "USE_GPS=false"]),
+    ("no rfid",      ["DEBUG_MODE=false", "USE_RFID=false"]),
+    ("no console",   ["DEBUG_MODE=false", "USE_CONSOLE=false"]),
+    ("minimal",      ["DEBUG_MODE=false", "USE_LCD=false", "USE_GPS=false",
+                      "USE_MODEM=false", "USE_RFID=false", "USE_LIGHT=false",
+                      "USE_CONSOLE=false"]),
+    ("modem test",   ["APP_MODE=1"]),
+    ("servo test",   ["APP_MODE=2"]),
+    ("gps test",     ["APP_MODE=3"]),
+]
+
+
+def report_matrix(work, args):
+    print("%-14s %7s %7s %7s %7s" % ("config", "flash", "sram", "stack", "ram"))
+    failed = False
+    for name, defines in MATRIX:
+        m = measure(os.path.join(work, name.replace(" ", "_")), args.fqbn,
+                    defines + args.defines)
+        ram = m["sram"] + m["stack"] + args.heap_reserve
+        over = m["flash"] > args.flash_max or ram > args.ram_max
+        failed |= over
+        print("%-14s %7d %7d %7d %7d%s" % (name, m["flash"], m["sram"], m["stack"],
+                                          ram, "  OVER" if over else ""))
+    return 1 if failed else 0
+
+
+def host_latency(work, defines):
+    """host/loop_bench for one configuration -> (loops, avg, p99, max) or None on reset"""
+    exe = os.path.join(work, "loop_bench")
+    run(["make", "-s", "-C", HOST, "loop_bench", "LB_OUT=" + exe,
+         "LB_DEFS=" + " ".join("-D" + d for d in defines)])
+    res = subprocess.run([exe], stdout=subprocess.PIPE, universal_newlines=True)
+    m = re.search(r"loops (\d+)\s+avg ([\d.]+) ms\s+p99 ([\d.]+) ms\s+max ([\d.]+) ms", res.stdout)
+    if res.returncode != 0 or not m:
+        return None
+    return int(m.group(1)), float(m.group(2)), float(m.group(3)), float(m.group(4))
+
+
+def report_matrix_host(work, args):
+    print("%-14s %7s %7s %7s %7s %8s %8s %8s" % ("config", "flash", "sram", "stack", "ram",
+                                                 "avg ms", "p99 ms", "max ms"))
+    failed = False
+    for name, defines in MATRIX:
+        d = os.path.join(work, name.replace(" ", "_"))
+        os.makedirs(d, exist_ok=True)
+        lat = host_latency(d, defines + args.defines)
+        failed |= lat is None
+        cols = "%8.2f %8.1f %8.1f" % lat[1:] if lat else "%8s %8s %8s" % ("reset", "", "")
+        print("%-14s %7s %7s %7s %7s %s" % (name, "pending", "pending", "pending", "pending", cols))
+    return 1 if failed else 0
+
+
+# -------------------------------------------
+# REPORT
+# -------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description="Flash/SRAM/stack footprint for smart_bin")
+    ap.add_argument("--fqbn", default="arduino:avr:uno")
+    ap.add_argument("-D", dest="defines", action="append", default=[],
+                    help="extra -D define, e.g. -D DEBUG_MODE=false")
+    ap.add_argument("--flash-max", type=int, default=FLASH_TOTAL)
+    ap.add_argument("--ram-max", type=int, default=SRAM_TOTAL,
+                    help="budget for static SRAM + worst stack + heap reserve")
+    ap.add_argument("--heap-reserve", type=int, default=200,
+                    help="bytes kept free for String temporaries")
+    ap.add_argument("--top", type=int, default=20, help="symbols to print")
+    ap.add_argument("--csv", help="write per-symbol breakdown to this file")
+    ap.add_argument("--build-dir", help="keep build output here")
+    ap.add_argument("--matrix", action="store_true",
+                    help="compare flash/SRAM/stack across module configurations")
+    ap.add_argument("--host", action="store_true",
+                    help="with --matrix: loop() latency from the host build, no AVR toolchain")
+    args = ap.parse_args()
+
+    work = args.build_dir or tempfile.mkdtemp(prefix="smart_bin_fp_")
+
+    if args.matrix and args.host:
+        return report_matrix_host(work, args)
+    if args.matrix:
+        return report_matrix(work, args)
+
+    m = measure(work, args.fqbn, args.defines)
+    text, data, bss, noinit = m["text"], m["data"], m["bss"], m["noinit"]
+    flash, sram, stack = m["flash"], m["sram"], m["stack"]
+    main_stack, isr_stack = m["main_stack"], m["isr_stack"]
+    frames, dynamic, indirect = m["frames"], m["dynamic"], m["indirect"]
+    graph, worst, elf = m["graph"], m["worst"], m["elf"]
+    ram_total = sram + stack + args.heap_reserve
+
+    print("=" * 56)
+    print(" SMART BIN footprint  (%s)" % args.fqbn)
+    if args.defines:
+        print(" defines: %s" % " ".join(args.defines))
+    print("=" * 56)
+    print(" Flash  %6d / %6d  (.text %d + .data %d)" % (flash, args.flash_max, text, data))
+    print(" SRAM   %6d static    (.data %d + .bss %d + .noinit %d)" % (sram, data, bss, noinit))
+    print(" Stack  %6d worst     (main %d + ISR %d)" % (stack, main_stack[0], isr_stack[0]))
+    print(" Heap   %6d reserved" % args.heap_reserve)
+    print(" RAM    %6d / %6d  (static + stack + heap)" % (ram_total, args.ram_max))
+    print("-" * 56)
+    print(" Deepest path from main:")
+    print("   " + " -> ".join(main_stack[1]))
+    if isr_stack[0]:
+        print(" Deepest ISR: " + " -> ".join(isr_stack[1]))
+    for src, dst in WATCH_PATHS:
+        p = path_depth(graph, frames, src, dst)
+        if p:
+            print(" %s -> %s: %d bytes" % (src, dst, p[0]))
+            print("   " + " -> ".join(p[1]))
+        else:
+            print(" %s -> %s: not found in call graph" % (src, dst))
+    unknown = sorted(fn for fn in indirect if fn in worst)
+    if unknown:
+        print(" Indirect calls (not followed): " + ", ".join(unknown[:8]))
+    if dynamic:
+        print(" Dynamic frames (alloca/VLA): " + ", ".join(sorted(dynamic)[:8]))
+    print("-" * 56)
+
+    syms = symbols(elf)
+    print(" Top %d symbols:" % args.top)
+    for name, region, kind, size in syms[:args.top]:
+        print("   %6d  %-5s %s" % (size, region, name))
+    print(" Top %d stack frames:" % min(args.top, len(frames)))
+    for name, size in sorted(frames.items(), key=lambda f: -f[1])[:args.top]:
+        print("   %6d  %s" % (size, name))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["symbol", "region", "type", "size", "stack_frame", "stack_worst"])
+            for name, region, kind, size in syms:
+                key = base_name(name)
+                w.writerow([name, region, kind, size,
+                            frames.get(key, ""),
+                            worst[key][0] if key in worst else ""])
+        print(" Per-symbol breakdown -> %s" % args.csv)
+
+    failed = []
+    if flash > args.flash_max:
+        failed.append("flash %d > %d" % (flash, args.flash_max))
+    if ram_total > args.ram_max:
+        failed.append("ram %d > %d" % (ram_total, args.ram_max))
+    print("=" * 56)
+    if failed:
+        print(" BUDGET EXCEEDED: " + "; ".join(failed))
+        return 1
+    print(" Within budget")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())